@@ -0,0 +1,43 @@
+#include <cstdlib>
+#include <new>
+#include "alloc_counter.hpp"
+
+static unsigned long long allocations = 0;
+
+unsigned long long allocation_count()
+{
+	return allocations;
+}
+
+void* operator new(std::size_t size)
+{
+	allocations += 1;
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Replaces the global operator new/delete for a bench executable and counts every allocation
+unsigned long long allocation_count();
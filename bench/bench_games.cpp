@@ -0,0 +1,199 @@
+// Frame-time benchmark for every subgame, run against the headless pc backend.
+//
+// Switches to each entry of game_list, waits out the transition, then runs a fixed
+// number of frames with a deterministic scripted input stream. Each frame is split
+// into the same phases onFrame runs (step_frame, draw_frame, render) and timed on its
+// own, together with the heap allocations the frame made. Results are written as
+// JSON so runs from different commits can be compared.
+//
+//   brickgame_bench [--frames N] [--out file.json] [--no-frame-reuse]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <game.h>
+#include <utils/settings.h>
+#include <utils/scores.h>
+#include <platform/audio_layer.h>
+#include <platform/graphics_layer.h>
+#include <platform/pc/application_pc.h>
+#include <platform/pc/control_layer_pc.h>
+#include "alloc_counter.hpp"
+
+using bench_clock = std::chrono::steady_clock;
+
+struct game_samples
+{
+	std::vector<double> step;
+	std::vector<double> draw;
+	std::vector<double> render;
+	std::vector<double> frame;
+	std::vector<double> allocations;
+};
+
+// Fixed pattern over the directions and A. The menu never gets A, or it would start a game.
+static unsigned int scripted_input(unsigned int frame, bool allow_A)
+{
+	unsigned int buttons = 0;
+	if ((frame / 4) % 9 == 0)
+		buttons |= pc_button_left;
+	if ((frame / 4) % 9 == 4)
+		buttons |= pc_button_right;
+	if (frame % 23 == 0)
+		buttons |= pc_button_up;
+	if ((frame / 3) % 11 == 0)
+		buttons |= pc_button_down;
+	if (allow_A && frame % 17 == 0)
+		buttons |= pc_button_A;
+	return buttons;
+}
+
+static double microseconds(bench_clock::time_point from, bench_clock::time_point to)
+{
+	return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+// mean/p50/p99/max of one phase
+static nlohmann::json summarize(std::vector<double> samples)
+{
+	nlohmann::json summary;
+	if (samples.empty())
+		return summary;
+
+	std::sort(samples.begin(), samples.end());
+
+	double total = 0;
+	for (double sample : samples)
+		total += sample;
+
+	summary["mean"] = total / samples.size();
+	summary["p50"] = samples.at(samples.size() / 2);
+	summary["p99"] = samples.at(std::min(samples.size() - 1, (size_t)(samples.size() * 0.99)));
+	summary["max"] = samples.back();
+	return summary;
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int frames_per_game = 5000;
+	std::string out_path = "brickgame_bench.json";
+	bool frame_reuse = true;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+			frames_per_game = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+			out_path = argv[++i];
+		else if (strcmp(argv[i], "--no-frame-reuse") == 0)
+			frame_reuse = false;
+		else
+		{
+			printf("usage: %s [--frames N] [--out file.json] [--no-frame-reuse]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// Fresh settings and scores every run, so nothing left in the working folder leaks in
+	std::string config_path = (std::filesystem::temp_directory_path() / "brickgame_bench_XXXXXX").string();
+	if (mkdtemp(&config_path[0]) == NULL)
+	{
+		printf("Couldn't make a config folder in %s\n", config_path.c_str());
+		return 1;
+	}
+	set_config_path_pc(config_path);
+
+	init_settings();
+	init_audio();
+	read_scores();
+	start_score_writer();
+	srand(1);
+
+	BrickGameFramework app;
+	gfx_set_reuse_unchanged_frames(frame_reuse);
+
+	u64 time_ns = 0;
+	unsigned int input_frame = 0;
+	bool allow_A = true;
+	set_input_script_pc([&](unsigned int) { return scripted_input(input_frame, allow_A); });
+
+	nlohmann::json results;
+	results["frames_per_game"] = frames_per_game;
+	results["frame_reuse"] = frame_reuse;
+	results["games"] = nlohmann::json::array();
+
+	for (unsigned int game_index = 0; game_index < game_list.size(); game_index++)
+	{
+		allow_A = (game_index != 0);
+		input_frame = 0;
+
+		// Let the transition into the game finish first
+		app.SwitchToGame(game_index);
+		for (int i = 0; i < 1000 && !(i > 0 && app.transition_stage == -1); i++)
+		{
+			time_ns += CApplication::frame_time_ns;
+			app.onFrame(time_ns);
+		}
+
+		game_samples samples;
+		samples.step.reserve(frames_per_game);
+		samples.draw.reserve(frames_per_game);
+		samples.render.reserve(frames_per_game);
+		samples.frame.reserve(frames_per_game);
+		samples.allocations.reserve(frames_per_game);
+
+		for (unsigned int frame = 0; frame < frames_per_game; frame++)
+		{
+			input_frame = frame;
+			time_ns += CApplication::frame_time_ns;
+			unsigned long long allocations_before = allocation_count();
+
+			bench_clock::time_point start = bench_clock::now();
+			app.step_frame();
+			bench_clock::time_point stepped = bench_clock::now();
+			gfx_start_frame();
+			app.draw_frame();
+			bench_clock::time_point drawn = bench_clock::now();
+			app.render(time_ns);
+			gfx_end_frame();
+			bench_clock::time_point rendered = bench_clock::now();
+
+			samples.step.push_back(microseconds(start, stepped));
+			samples.draw.push_back(microseconds(stepped, drawn));
+			samples.render.push_back(microseconds(drawn, rendered));
+			samples.frame.push_back(microseconds(start, rendered));
+			samples.allocations.push_back((double)(allocation_count() - allocations_before));
+		}
+
+		nlohmann::json game_result;
+		game_result["name"] = game_list.at(game_index)->name;
+		game_result["step_us"] = summarize(samples.step);
+		game_result["draw_us"] = summarize(samples.draw);
+		game_result["render_us"] = summarize(samples.render);
+		game_result["frame_us"] = summarize(samples.frame);
+		game_result["allocations_per_frame"] = summarize(samples.allocations);
+		results["games"].push_back(game_result);
+	}
+
+	stop_score_writer();
+	std::filesystem::remove_all(config_path);
+
+	std::ofstream out(out_path);
+	out << results.dump(1, '\t') << std::endl;
+
+	fprintf(stderr, "\n%-12s %10s %10s %10s %10s\n", "game", "frame us", "p99 us", "max us", "allocs");
+	for (const nlohmann::json& game_result : results["games"])
+		fprintf(stderr, "%-12s %10.2f %10.2f %10.2f %10.2f\n", game_result["name"].get<std::string>().c_str(),
+			game_result["frame_us"]["mean"].get<double>(), game_result["frame_us"]["p99"].get<double>(),
+			game_result["frame_us"]["max"].get<double>(), game_result["allocations_per_frame"]["mean"].get<double>());
+	fprintf(stderr, "Results written to %s\n", out_path.c_str());
+
+	return 0;
+}
@@ -0,0 +1,80 @@
+// Micro-benchmark for the board read path used by renderGame/draw_grid.
+//
+// Compares the old nested vector<vector<bool>> grid_get (which copied a whole column
+// on every read) against the packed Grid with grid_get / grid_get_unchecked, on the
+// 10x20 board. Reports heap allocations and time per simulated frame.
+//
+// Built as brickgame_bench_grid by the CMake host build, or by hand:
+//   g++ -std=c++17 -O2 -Iinclude bench/bench_grid.cpp bench/alloc_counter.cpp source/grid.cpp -o bench_grid
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <grid.hpp>
+#include "alloc_counter.hpp"
+
+// The grid_get that shipped before the packed Grid, kept here as the baseline
+static bool legacy_grid_get(std::vector<std::vector<bool>>& grid, int x, int y)
+{
+	if (x >= 0 && x < (int)grid.size())
+	{
+		std::vector<bool> sub = grid.at(x);
+		if (y >= 0 && y < (int)sub.size())
+		{
+			return sub.at(y);
+		}
+	}
+
+	return false;
+}
+
+// One frame of renderGame's reads: four lookups per 2x2 block
+template <typename Get>
+static unsigned int read_frame(int width, int height, Get get)
+{
+	unsigned int checksum = 0;
+	for (int i = 0; i < width; i += 2)
+		for (int j = 0; j < height; j += 2)
+			checksum += 1 * get(i, j) + 2 * get(i + 1, j) + 4 * get(i, j + 1) + 8 * get(i + 1, j + 1);
+	return checksum;
+}
+
+template <typename Get>
+static void run(const char* label, int frames, int width, int height, Get get)
+{
+	unsigned long long allocations_before = allocation_count();
+	unsigned int checksum = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int f = 0; f < frames; f++)
+		checksum += read_frame(width, height, get);
+	auto end = std::chrono::steady_clock::now();
+
+	double ns = std::chrono::duration<double, std::nano>(end - start).count();
+	printf("%-22s %10.2f allocs/frame %10.1f ns/frame (checksum %u)\n", label,
+		(double)(allocation_count() - allocations_before) / frames, ns / frames, checksum);
+}
+
+int main(int argc, char* argv[])
+{
+	const int width = 10;
+	const int height = 20;
+	const int frames = (argc > 1) ? atoi(argv[1]) : 10000;
+
+	std::vector<std::vector<bool>> legacy(width, std::vector<bool>(height, false));
+	Grid packed = grid_create(width, height);
+	for (int i = 0; i < width; i++)
+		for (int j = 0; j < height; j++)
+		{
+			bool on = ((i * 7 + j * 3) % 5) == 0;
+			legacy[i][j] = on;
+			grid_set(packed, i, j, on);
+		}
+
+	run("legacy grid_get", frames, width, height, [&](int x, int y) { return legacy_grid_get(legacy, x, y); });
+	run("grid_get", frames, width, height, [&](int x, int y) { return grid_get(packed, x, y); });
+	run("grid_get_unchecked", frames, width, height, [&](int x, int y) { return grid_get_unchecked(packed, x, y); });
+
+	return 0;
+}
@@ -5,15 +5,15 @@
 #include <string>
 #include <array>
 #include <optional>
+#include <memory>
 #include <unistd.h>
 #include "perf.hpp"
 #include <utils.hpp>
 #include <grid.hpp>
 #include <vector>
-#include <nanovg/framework/CMemPool.h>
-#include <nanovg/framework/CApplication.h>
-#include <nanovg/dk_renderer.hpp>
+#include <platform/application.h>
 #include <games/subgame.h>
+#include <platform/graphics_layer.h>
 
 class BrickGameFramework;
 
@@ -26,12 +26,33 @@ enum enum_orientation {
 
 extern vector<std::unique_ptr<subgame>> game_list;
 
+// Sprite and font handles, loaded once in the BrickGameFramework constructor
+struct game_resources
+{
+	SpriteId spr_cell_selected;
+	SpriteId spr_cell_unselected;
+	SpriteId spr_page_blip_selected;
+	SpriteId spr_page_blip_unselected;
+
+	FontId fnt_sans;
+	FontId fnt_sans_bold;
+	FontId fnt_emoji;
+	FontId fnt_icons;
+	FontId fnt_seg;
+	FontId fnt_minecraft;
+	FontId fnt_kongtext;
+	FontId fnt_vcrtext;
+};
+
+extern game_resources resources;
+
 class BrickGameFramework : public CApplication
 {
 private:
 	int current_game;
 	int next_game;
 	std::string current_game_name;
+	int current_score_id = -1;
 
 	PerfGraph fps;
 	float prevTime;
@@ -42,6 +63,18 @@ private:
 	std::string highscore_display = "";
 	std::string score_display = "";
 
+	// Controls panel text, rebuilt only when the running game changes
+	std::string controls_text = "";
+	int controls_text_game = -1;
+
+	// Fixed-timestep clock, see onFrame
+	u64 tick_ns = 1000000000ULL / 60;
+	u64 tick_accumulator_ns = 0;
+	u64 last_frame_ns = 0;
+	bool clock_started = false;
+	// ZL/ZR held as of the last tick
+	bool fast_forward = false;
+
 public:
 
 	bool running;
@@ -49,10 +82,32 @@ public:
 	BrickGameFramework();
 	~BrickGameFramework();
 
+	// onFrame runs these in order, they're public so profilers can time each phase.
+	// step_frame is one simulation tick, onFrame runs as many of them as the time since
+	// the last frame covers and then draws once.
+	bool step_frame();
+	void draw_frame();
 	void render(u64 ns);
 	bool onFrame(u64 ns) override;
 
-	vector<vector<bool>> game_grid;
+	// Everything counted in frames (time_til_move, tickers, transitions) is counted in
+	// ticks of this rate
+	void set_tick_rate(unsigned int ticks_per_second);
+	unsigned int tick_rate() const;
+	// Runs ticks back to back with no drawing or clock, for headless runs and tests
+	bool simulate_ticks(unsigned int tick_count);
+
+	// After a stall, at most this many ticks run before drawing, the rest is dropped
+	unsigned int max_ticks_per_frame = 5;
+	// Ticks per tick's worth of real time. Games don't see this, they just get more
+	// ticks per frame. ZL/ZR switch to fast_forward_scale while held.
+	unsigned int time_scale = 1;
+	unsigned int fast_forward_scale = 4;
+	// How far between the last tick and the next this frame is drawn, 0 to 1. Anything
+	// that moves smoothly can draw at previous + (current - previous) * tick_interpolation.
+	float tick_interpolation = 0;
+
+	Grid game_grid;
 
 	char screen_orientation;
 	int transition_stage;
@@ -70,17 +125,13 @@ public:
 	void setHighScoreDisplay(std::string score);
 	void setScore(int score);
 	void setScore(double score);
-	void setScore(std::string score);
 	void incrementScore(int amount);
-	void setHighScore(std::string score);
+	void setHighScore(int64_t score);
 
 	void SwitchToGame(int i);
 };
 
-static bool fast_forward = false;
-double fast_forwarder_half();
-
-void draw_grid(vector<vector<bool>> _grid, float _x, float _y, double cell_size);
+void draw_grid(const Grid& _grid, float _x, float _y, double cell_size);
 
 void renderGame(BrickGameFramework& game, float mx, float my, float t);
 
@@ -39,6 +39,8 @@ public:
 	virtual void subgame_demo() override;
 	virtual std::string subgame_controls_text() override;
 
+	void show_selected_highscore();
+
 	int selected_game = 0;
 	unsigned int ticker = 0;
 };
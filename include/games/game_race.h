@@ -6,7 +6,7 @@
 #include <vector>
 using namespace std;
 
-extern vector<vector<bool>> grid_sprite_racecar;
+extern Grid grid_sprite_racecar;
 
 class subgame_race : public subgame
 {
@@ -16,12 +16,12 @@ public:
 		virtual void step_function() override;
 		virtual void draw_function() override;
 		virtual void destroy_function() override;
-		vector<vector<bool>> filled_blocks;
+		Grid filled_blocks;
 		void shift_down();
 		void check_rows();
-		int lowest_occupied_line(std::vector<std::vector<bool>>& grid);
+		int lowest_occupied_line(Grid& grid);
 		void lose();
-		void generate_row(std::vector<std::vector<bool>>& grid, int row_num);
+		void generate_row(Grid& grid, int row_num);
 		int pause_time;
 		int time_til_move;
 	};
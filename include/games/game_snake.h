@@ -24,6 +24,7 @@ public:
 		void die();
 		unsigned last_direction;
 		int time_til_move;
+		vector<point> tail;
 	};
 	subgame_snake(BrickGameFramework& game);
 
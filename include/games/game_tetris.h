@@ -3,17 +3,77 @@
 #define TETRIS_H
 
 #include <object_manager.h>
+#include <games/game_tetris_shapes.h>
+#include <games/game_tetris_ai.h>
+#include <games/game_tetris_pieces.h>
 
 using namespace std;
-		vector<vector<bool>> get_sprite(int index, int rotation);
+
+void place_tetromino(Grid& grid, const tetromino_rotation& shape, int x, int y);
+
+// Tests piece placements against a board of locked blocks by mask. It only holds a
+// reference, so make one wherever it's needed. Nothing here allocates, so an AI or a
+// replay check can run thousands of tests a frame.
+//   0 - No Collision
+//   1 - Off Board Side Left
+//   2 - Off Board Side Right
+//   3 - Off Board Bottom
+//   4 - Another Piece
+//   5 - Off Board Top (test_off_top only)
+struct tetris_collision
+{
+	const Grid& board;
+	int width;
+	int height;
+
+	int test(const tetromino_rotation& shape, int x, int y) const;
+	int test_off_top(const tetromino_rotation& shape, int x, int y) const;
+	// Turns the piece one step in place if it fits, otherwise at the first SRS kick that
+	// does, updating rotation and position. False if nothing fits.
+	bool rotate(int piece, int& rotation, int& x, int& y, bool clockwise) const;
+	// Rows the piece can fall before it lands, found by testing one row at a time
+	int drop_distance(const tetromino_rotation& shape, int x, int y) const;
+};
 
 class subgame_tetris : public subgame
 {
 public:
 	int phase = -1;
-	vector<int> highlighted_rows;
+	uint64_t highlighted_rows = 0;
 	int ticker = 0;
-	int next_piece = 0;
+	int lines_cleared = 0;
+
+	// Where pieces come from. A seed of 0 picks a new one every game.
+	tetris_piece_queue pieces;
+	tetris_randomizer randomizer = tetris_randomizer_bag;
+	uint64_t seed = 0;
+	// Pieces shown coming up, at most tetris_preview_max
+	int preview_count = 3;
+	// Only rebuilt when a piece is taken or preview_count changes
+	Grid preview_grid;
+	unsigned int preview_taken = 0;
+	void build_preview();
+
+	// Ticks a landed piece waits before it locks, 0 locks on landing
+	int lock_delay = 30;
+	// Blinks where the piece would land
+	bool show_ghost = true;
+
+	// Pieces steer themselves to the placement search's pick instead of reading input
+	bool autoplay = false;
+	tetris_ai_weights ai_weights;
+
+	// The menu demo plays its own board with the placement search
+	Grid demo_board;
+	tetris_piece_queue demo_pieces;
+	int demo_piece = 0;
+	int demo_angle = 0;
+	int demo_x = 0;
+	int demo_y = 0;
+	tetris_placement demo_target;
+	unsigned int demo_tick = 0;
+	void demo_reset();
+	void demo_step();
 
 	class obj_tetris_rows : public game_object
 	{
@@ -22,10 +82,18 @@ public:
 		virtual void step_function() override;
 		virtual void draw_function() override;
 		virtual void destroy_function() override;
-		vector<vector<bool>> filled_blocks;
+		Grid filled_blocks;
+		// Row of the highest block in each column, the board height when it's empty.
+		// Kept up to date as pieces lock, rebuilt when rows are removed.
+		int skyline[Grid::max_width];
+		void rebuild_skyline();
+		void lock_piece(const tetromino_rotation& shape, int x, int y);
+		// Rows a piece falls before it lands, or -1 when part of it is already under the
+		// skyline (tucked under an overhang) and the skyline can't tell
+		int drop_distance(const tetromino_rotation& shape, int x, int y);
 		void shift_down(int starting_at);
 		void check_rows();
-		int lowest_occupied_line(std::vector<std::vector<bool>>& grid);
+		int lowest_occupied_line(Grid& grid);
 	};
 
 	class obj_tetromino : public game_object
@@ -41,16 +109,37 @@ public:
 
 		bool moving = true;
 
+		// Set by the subgame when the piece spawns
+		int lock_delay = 0;
+		bool ghost = false;
+		// Ticks spent landed, and how many moves on the ground have put that back to 0
+		int lock_timer = 0;
+		int lock_resets = 0;
+		static constexpr int max_lock_resets = 15;
+		int lowest_y = 0;
+
+		// Set by the subgame when autoplay is on
+		bool ai = false;
+		tetris_placement target;
+		void ai_step();
+
+		// The locked blocks, found once when the piece spawns
+		obj_tetris_rows* rows = NULL;
+		tetris_collision collision();
+
 		obj_tetromino(BrickGameFramework& game, int _x, int _y, int piece_type);
 		virtual void step_function() override;
 		virtual void draw_function() override;
 		virtual void destroy_function() override;
 
-		void check_spots(vector<vector<int>> potentials, vector<vector<bool>> sprite, int direction);
-		int check_collision(vector<vector<bool>> shape, int _x, int _y);
-		int check_off_top(vector<vector<bool>> shape, int _x, int _y);
+		int check_collision(const tetromino_rotation& shape, int _x, int _y);
+		int check_off_top(const tetromino_rotation& shape, int _x, int _y);
+		int drop_distance();
+		void refresh_lock();
+		void update_lock();
+		void lock();
+		void hard_drop();
 		void lose();
-		void change_rotation_by(int i);
 		void move_left();
 		void move_right();
 		void move_down();
@@ -0,0 +1,45 @@
+#pragma once
+#include <grid.hpp>
+#include <games/game_tetris_shapes.h>
+
+// Placement search for the menu demo and autoplay. Everything works on packed Grid
+// rows and copies boards by value, so a search never touches the heap.
+
+// Higher board scores are better. The defaults are Yiyuan Lee's tuned weights for a
+// 10 wide board: lines cleared pay, everything else costs.
+struct tetris_ai_weights
+{
+	float aggregate_height = -0.510066f;
+	float lines = 0.760666f;
+	float holes = -0.35663f;
+	float bumpiness = -0.184483f;
+};
+
+// Where a piece comes to rest: its rotation and the x/y of its 4x4 box
+struct tetris_placement
+{
+	int rotation = 0;
+	int x = 0;
+	int y = 0;
+	float score = 0;
+	bool valid = false;
+};
+
+constexpr int tetris_max_placements = tetromino_rotations * Grid::max_width;
+// Score given to placements that lock above the board
+constexpr float tetris_losing_score = -1e9f;
+
+// Every spot a piece entering at (x, y) can rest in by turning in place (with kicks),
+// sliding sideways, then dropping straight down. Returns how many were written.
+int tetris_enumerate_placements(const Grid& board, int piece, int x, int y, tetris_placement (&placements)[tetris_max_placements]);
+
+// Locks the piece into the board and removes full rows, returns the rows removed
+int tetris_apply_placement(Grid& board, int piece, const tetris_placement& placement);
+
+float tetris_evaluate(const Grid& board, int lines, const tetris_ai_weights& weights);
+
+// Best placement for piece entering at (x, y), looking one piece ahead when next_piece
+// is 0 or more. Candidate first moves are scored independently, split over threads
+// when threads > 1. The result isn't valid if the piece has nowhere to go.
+tetris_placement tetris_find_best_placement(const Grid& board, int piece, int next_piece, int x, int y,
+	const tetris_ai_weights& weights, int threads = 1);
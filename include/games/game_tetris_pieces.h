@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <games/game_tetris_shapes.h>
+
+// Small seedable PRNG (xorshift64*). The same seed gives the same numbers on every
+// platform, unlike rand().
+struct tetris_random
+{
+	uint64_t state = 1;
+
+	void seed(uint64_t seed);
+	uint32_t next();
+	// 0 to count - 1
+	int below(int count);
+};
+
+enum tetris_randomizer
+{
+	// Each of the seven once per shuffled bag, no droughts longer than 12 pieces
+	tetris_randomizer_bag,
+	// NES style: roll one of seven, roll again once if it repeats the last piece
+	tetris_randomizer_classic
+};
+
+// Most pieces the preview can show
+constexpr int tetris_preview_max = 6;
+
+// Deals pieces from a seed and keeps tetris_preview_max of them dealt ahead, so what
+// comes out only depends on the seed and mode, never on how much is previewed.
+struct tetris_piece_queue
+{
+	void reset(uint64_t seed, tetris_randomizer mode);
+	// Takes the next piece and deals one more onto the end
+	int next();
+	// Upcoming piece, 0 is the one next() returns
+	int peek(int index) const;
+
+	// Pieces taken so far, changes whenever the preview does
+	unsigned int taken = 0;
+
+private:
+	int deal();
+
+	tetris_random random;
+	tetris_randomizer mode = tetris_randomizer_bag;
+	int bag[tetromino_count] = {};
+	int bag_left = 0;
+	int last_dealt = -1;
+
+	int upcoming[tetris_preview_max] = {};
+	int first = 0;
+};
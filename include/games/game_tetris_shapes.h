@@ -1,258 +1,136 @@
 #pragma once
-#include <vector>
-
-vector<vector<bool>> shape_a0
-{
-	{0, 0, 0, 0},
-	{1, 1, 1, 1},
-	{0, 0, 0, 0},
-	{0, 0, 0, 0}
-};
-
-vector<vector<bool>> shape_a1
-{
-	{0, 0, 1, 0},
-	{0, 0, 1, 0},
-	{0, 0, 1, 0},
-	{0, 0, 1, 0}
-};
-
-vector<vector<bool>> shape_a2
-{
-	{0, 0, 0, 0},
-	{0, 0, 0, 0},
-	{1, 1, 1, 1},
-	{0, 0, 0, 0}
-};
-
-vector<vector<bool>> shape_a3
-{
-	{0, 1, 0, 0},
-	{0, 1, 0, 0},
-	{0, 1, 0, 0},
-	{0, 1, 0, 0}
-};
-
-vector<vector<vector<bool>>> shape_a
-{
-	shape_a0,
-	shape_a1,
-	shape_a2,
-	shape_a3
-};
-
-//
-
-vector<vector<bool>> shape_b0
-{
-	{1, 0, 0},
-	{1, 1, 1},
-	{0, 0, 0}
-};
-
-vector<vector<bool>> shape_b1
-{
-	{0, 1, 1},
-	{0, 1, 0},
-	{0, 1, 0}
-};
-
-vector<vector<bool>> shape_b2
-{
-	{0, 0, 0},
-	{1, 1, 1},
-	{0, 0, 1}
-};
-
-vector<vector<bool>> shape_b3
-{
-	{0, 1, 0},
-	{0, 1, 0},
-	{1, 1, 0}
-};
-
-vector<vector<vector<bool>>> shape_b
-{
-	shape_b0,
-	shape_b1,
-	shape_b2,
-	shape_b3
-};
-
-//
-
-vector<vector<bool>> shape_c0
-{
-	{0, 0, 1},
-	{1, 1, 1},
-	{0, 0, 0}
-};
-
-vector<vector<bool>> shape_c1
-{
-	{0, 1, 0},
-	{0, 1, 0},
-	{0, 1, 1}
-};
-
-vector<vector<bool>> shape_c2
-{
-	{0, 0, 0},
-	{1, 1, 1},
-	{1, 0, 0}
-};
-
-vector<vector<bool>> shape_c3
-{
-	{1, 1, 0},
-	{0, 1, 0},
-	{0, 1, 0}
-};
-
-vector<vector<vector<bool>>> shape_c
-{
-	shape_c0,
-	shape_c1,
-	shape_c2,
-	shape_c3
-};
-
-//
-
-vector<vector<bool>> shape_d0
-{
-	{1, 1},
-	{1, 1}
-};
-
-vector<vector<vector<bool>>> shape_d
-{
-	shape_d0
-};
-
-//
-
-vector<vector<bool>> shape_e0
-{
-	{0, 1, 1},
-	{1, 1, 0},
-	{0, 0, 0}
-};
-
-vector<vector<bool>> shape_e1
-{
-	{0, 1, 0},
-	{0, 1, 1},
-	{0, 0, 1}
-};
-
-vector<vector<bool>> shape_e2
-{
-	{0, 0, 0},
-	{0, 1, 1},
-	{1, 1, 0}
-};
-
-vector<vector<bool>> shape_e3
-{
-	{1, 0, 0},
-	{1, 1, 0},
-	{0, 1, 0}
-};
-
-vector<vector<vector<bool>>> shape_e
-{
-	shape_e0,
-	shape_e1,
-	shape_e2,
-	shape_e3
-};
-
-//
-
-vector<vector<bool>> shape_f0
-{
-	{0, 1, 0},
-	{1, 1, 1},
-	{0, 0, 0}
-};
-
-vector<vector<bool>> shape_f1
-{
-	{0, 1, 0},
-	{0, 1, 1},
-	{0, 1, 0}
-};
-
-vector<vector<bool>> shape_f2
-{
-	{0, 0, 0},
-	{1, 1, 1},
-	{0, 1, 0}
-};
-
-vector<vector<bool>> shape_f3
-{
-	{0, 1, 0},
-	{1, 1, 0},
-	{0, 1, 0}
-};
-
-vector<vector<vector<bool>>> shape_f
-{
-	shape_f0,
-	shape_f1,
-	shape_f2,
-	shape_f3
-};
-
-//
-
-vector<vector<bool>> shape_g0
-{
-	{1, 1, 0},
-	{0, 1, 1},
-	{0, 0, 0}
-};
-
-vector<vector<bool>> shape_g1
-{
-	{0, 0, 1},
-	{0, 1, 1},
-	{0, 1, 0}
-};
-
-vector<vector<bool>> shape_g2
-{
-	{0, 0, 0},
-	{1, 1, 0},
-	{0, 1, 1}
-};
-
-vector<vector<bool>> shape_g3
-{
-	{0, 1, 0},
-	{1, 1, 0},
-	{1, 0, 0}
-};
-
-vector<vector<vector<bool>>> shape_g
-{
-	shape_g0,
-	shape_g1,
-	shape_g2,
-	shape_g3
-};
-
-//
-
-vector<vector<vector<vector<bool>>>> tetris_shapes
-{
-	shape_a,
-	shape_b,
-	shape_c,
-	shape_d,
-	shape_e,
-	shape_f,
-	shape_g
-};
\ No newline at end of file
+#include <cstdint>
+
+// Every tetromino rotation packed into 16 bits: a 4x4 box, row j in bits 4j..4j+3 and
+// column i at bit 4j + i, the same order Grid packs its rows. Placing or testing a
+// piece is one shift and AND per row against the board's packed rows.
+struct tetromino_rotation
+{
+	uint16_t mask;
+	// Occupied part of the 4x4 box, inclusive
+	int8_t left;
+	int8_t right;
+	int8_t top;
+	int8_t bottom;
+	// Lowest occupied row of each box column, -1 for empty columns
+	int8_t column_bottom[4];
+
+	constexpr uint64_t row(int j) const
+	{
+		return (mask >> (4 * j)) & 0xF;
+	}
+};
+
+// Rows top to bottom as one string of 16 '0'/'1' characters
+constexpr tetromino_rotation make_rotation(const char* cells)
+{
+	tetromino_rotation rotation = { 0, 4, -1, 4, -1, { -1, -1, -1, -1 } };
+	for (int j = 0; j < 4; j++)
+		for (int i = 0; i < 4; i++)
+			if (cells[j * 4 + i] == '1')
+			{
+				rotation.mask |= (uint16_t)(1 << (j * 4 + i));
+				if (i < rotation.left) rotation.left = i;
+				if (i > rotation.right) rotation.right = i;
+				if (j < rotation.top) rotation.top = j;
+				if (j > rotation.bottom) rotation.bottom = j;
+				rotation.column_bottom[i] = j;
+			}
+	return rotation;
+}
+
+constexpr int tetromino_count = 7;
+constexpr int tetromino_rotations = 4;
+
+// I, J, L, O, S, T, Z, each clockwise from spawn. O repeats its one rotation.
+constexpr tetromino_rotation tetromino_table[tetromino_count][tetromino_rotations] =
+{
+	// I
+	{
+		make_rotation("0000" "1111" "0000" "0000"),
+		make_rotation("0010" "0010" "0010" "0010"),
+		make_rotation("0000" "0000" "1111" "0000"),
+		make_rotation("0100" "0100" "0100" "0100"),
+	},
+	// J
+	{
+		make_rotation("1000" "1110" "0000" "0000"),
+		make_rotation("0110" "0100" "0100" "0000"),
+		make_rotation("0000" "1110" "0010" "0000"),
+		make_rotation("0100" "0100" "1100" "0000"),
+	},
+	// L
+	{
+		make_rotation("0010" "1110" "0000" "0000"),
+		make_rotation("0100" "0100" "0110" "0000"),
+		make_rotation("0000" "1110" "1000" "0000"),
+		make_rotation("1100" "0100" "0100" "0000"),
+	},
+	// O
+	{
+		make_rotation("1100" "1100" "0000" "0000"),
+		make_rotation("1100" "1100" "0000" "0000"),
+		make_rotation("1100" "1100" "0000" "0000"),
+		make_rotation("1100" "1100" "0000" "0000"),
+	},
+	// S
+	{
+		make_rotation("0110" "1100" "0000" "0000"),
+		make_rotation("0100" "0110" "0010" "0000"),
+		make_rotation("0000" "0110" "1100" "0000"),
+		make_rotation("1000" "1100" "0100" "0000"),
+	},
+	// T
+	{
+		make_rotation("0100" "1110" "0000" "0000"),
+		make_rotation("0100" "0110" "0100" "0000"),
+		make_rotation("0000" "1110" "0100" "0000"),
+		make_rotation("0100" "1100" "0100" "0000"),
+	},
+	// Z
+	{
+		make_rotation("1100" "0110" "0000" "0000"),
+		make_rotation("0010" "0110" "0100" "0000"),
+		make_rotation("0000" "1100" "0110" "0000"),
+		make_rotation("0100" "1100" "1000" "0000"),
+	},
+};
+
+// Width of the box each piece rotates in
+constexpr int tetromino_box_size[tetromino_count] = { 4, 3, 3, 2, 3, 3, 3 };
+
+constexpr const tetromino_rotation& tetromino_shape(int piece, int rotation)
+{
+	return tetromino_table[piece][((rotation % tetromino_rotations) + tetromino_rotations) % tetromino_rotations];
+}
+
+// SRS wall kicks in SRS coordinates (y up), tried in order until one fits.
+// Indexed by [rotation before][0 counter-clockwise, 1 clockwise][test].
+struct kick_offset
+{
+	int8_t x;
+	int8_t y;
+};
+
+constexpr int kick_tests = 5;
+
+constexpr kick_offset srs_kicks_i[tetromino_rotations][2][kick_tests] =
+{
+	{ { { 0, 0 }, { -1, 0 }, { 2, 0 }, { -1, 2 }, { 2, -1 } }, { { 0, 0 }, { -2, 0 }, { 1, 0 }, { -2, -1 }, { 1, 2 } } },
+	{ { { 0, 0 }, { 2, 0 }, { -1, 0 }, { 2, 1 }, { -1, -2 } }, { { 0, 0 }, { -1, 0 }, { 2, 0 }, { -1, 2 }, { 2, -1 } } },
+	{ { { 0, 0 }, { 1, 0 }, { -2, 0 }, { 1, -2 }, { -2, 1 } }, { { 0, 0 }, { 2, 0 }, { -1, 0 }, { 2, 1 }, { -1, -2 } } },
+	{ { { 0, 0 }, { -2, 0 }, { 1, 0 }, { -2, -1 }, { 1, 2 } }, { { 0, 0 }, { 1, 0 }, { -2, 0 }, { 1, -2 }, { -2, 1 } } },
+};
+
+constexpr kick_offset srs_kicks_jlstz[tetromino_rotations][2][kick_tests] =
+{
+	{ { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, -2 }, { 1, -2 } }, { { 0, 0 }, { -1, 0 }, { -1, 1 }, { 0, -2 }, { -1, -2 } } },
+	{ { { 0, 0 }, { 1, 0 }, { 1, -1 }, { 0, 2 }, { 1, 2 } }, { { 0, 0 }, { 1, 0 }, { 1, -1 }, { 0, 2 }, { 1, 2 } } },
+	{ { { 0, 0 }, { -1, 0 }, { -1, 1 }, { 0, -2 }, { -1, -2 } }, { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, -2 }, { 1, -2 } } },
+	{ { { 0, 0 }, { -1, 0 }, { -1, -1 }, { 0, 2 }, { -1, 2 } }, { { 0, 0 }, { -1, 0 }, { -1, -1 }, { 0, 2 }, { -1, 2 } } },
+};
+
+constexpr const kick_offset (&tetromino_kicks(int piece, int rotation, bool clockwise))[kick_tests]
+{
+	return (piece == 0 ? srs_kicks_i : srs_kicks_jlstz)[rotation][clockwise ? 1 : 0];
+}
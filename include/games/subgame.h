@@ -12,6 +12,8 @@ public:
 	BrickGameFramework& game;
 
 	std::string name;
+	// Record index in the score store, set once game_list is built
+	int score_id = -1;
 	virtual void subgame_init();
 	virtual void subgame_step();
 	virtual void subgame_draw();
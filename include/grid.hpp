@@ -1,13 +1,47 @@
 #pragma once
 #include <vector>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
 
 using namespace std;
 
-vector<vector<bool>> grid_create(int width, int height);
-bool point_in_grid(std::vector<std::vector<bool>>& grid, int x, int y);
-bool grid_set(vector<vector<bool>>& grid, int x, int y, bool val, bool additive = false);
-bool grid_get(vector<vector<bool>>& grid, int x, int y);
-int grid_width(vector<vector<bool>>& grid);
-int grid_height(vector<vector<bool>>& grid);
-void grid_clear(vector<vector<bool>>& grid);
-void emplace_grid_in_grid(vector<vector<bool>>& grid, vector<vector<bool>>& grid_to_place, int x, int y, bool additive);
\ No newline at end of file
+// Packed boolean grid. Every row is one 64-bit word (bit x is the cell at column x),
+// stored row-major in an inline buffer so the 10x20 / 20x20 boards and every sprite
+// live without touching the heap. Taller grids spill over into a heap buffer.
+class Grid
+{
+public:
+	static constexpr int max_width = 64;
+	static constexpr int max_height = 64;
+	static constexpr int inline_rows = 32;
+
+	Grid();
+	Grid(int width, int height);
+	// Row literals, written the way they look on screen: { { 0, 1, 0 }, { 1, 1, 1 } }
+	Grid(std::initializer_list<std::initializer_list<bool>> rows);
+
+	int width;
+	int height;
+
+	uint64_t* rows() { return (height <= inline_rows) ? inline_data.data() : heap_data.data(); }
+	const uint64_t* rows() const { return (height <= inline_rows) ? inline_data.data() : heap_data.data(); }
+
+	// Bits that are inside the grid for a single row
+	uint64_t row_mask() const { return (width >= 64) ? ~(uint64_t)0 : (((uint64_t)1 << width) - 1); }
+
+private:
+	std::array<uint64_t, inline_rows> inline_data;
+	std::vector<uint64_t> heap_data;
+};
+
+Grid grid_create(int width, int height);
+bool point_in_grid(const Grid& grid, int x, int y);
+bool grid_set(Grid& grid, int x, int y, bool val, bool additive = false);
+bool grid_get(const Grid& grid, int x, int y);
+// Same as grid_get without the bounds check, the caller guarantees point_in_grid(grid, x, y)
+inline bool grid_get_unchecked(const Grid& grid, int x, int y) { return (grid.rows()[y] >> x) & 1; }
+int grid_width(const Grid& grid);
+int grid_height(const Grid& grid);
+void grid_clear(Grid& grid);
+void emplace_grid_in_grid(Grid& grid, const Grid& grid_to_place, int x, int y, bool additive);
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <grid.hpp>
+
+// Whole-row operations on a packed Grid. Rows are single words, so each of these
+// costs one compare or move per row instead of a grid_get/grid_set per cell.
+// Row masks use bit y for row y (grids are at most Grid::max_height = 64 tall).
+
+// Bit y is set when every cell of row y is filled
+uint64_t row_full_mask(const Grid& grid);
+// Removes the rows in the mask. Rows above fall down into the gaps, or with
+// toward_top the rows below rise up instead. Returns the number of rows removed.
+int collapse_rows(Grid& grid, uint64_t mask, bool toward_top = false);
+// Removes the given row by moving every row above it down by one, row 0 comes in empty
+void shift_down_from(Grid& grid, int row);
+void fill_row(Grid& grid, int row, bool val);
+// Bottom-most row with anything in it, or -1 if the grid is empty
+int lowest_occupied_row(const Grid& grid);
\ No newline at end of file
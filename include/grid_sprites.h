@@ -5,6 +5,6 @@
 #include <grid.hpp>
 using namespace std;
 
-extern vector<vector<bool>> grid_sprite_three_x_three_square;
+extern Grid grid_sprite_three_x_three_square;
 
-void place_grid_sprite(vector<vector<bool>>& grid, vector<vector<bool>>& sprite_name, int x, int y, bool additive = true);
\ No newline at end of file
+void place_grid_sprite(Grid& grid, const Grid& sprite_name, int x, int y, bool additive = true);
\ No newline at end of file
@@ -1,10 +1,11 @@
 #pragma once
 #include <vector>
+#include <grid.hpp>
 using namespace std;
 
-extern vector<vector<bool>> grid_sprite_alphabet_c;
-extern vector<vector<bool>> grid_sprite_alphabet_e;
-extern vector<vector<bool>> grid_sprite_alphabet_l;
-extern vector<vector<bool>> grid_sprite_alphabet_m;
-extern vector<vector<bool>> grid_sprite_alphabet_o;
-extern vector<vector<bool>> grid_sprite_alphabet_w;
\ No newline at end of file
+extern Grid grid_sprite_alphabet_c;
+extern Grid grid_sprite_alphabet_e;
+extern Grid grid_sprite_alphabet_l;
+extern Grid grid_sprite_alphabet_m;
+extern Grid grid_sprite_alphabet_o;
+extern Grid grid_sprite_alphabet_w;
\ No newline at end of file
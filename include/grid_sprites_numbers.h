@@ -1,15 +1,16 @@
 #pragma once
 #include <vector>
+#include <grid.hpp>
 using namespace std;
 
-extern vector<vector<bool>> grid_sprite_alphabet_0;
-extern vector<vector<bool>> grid_sprite_alphabet_1;
-extern vector<vector<bool>> grid_sprite_alphabet_2;
-extern vector<vector<bool>> grid_sprite_alphabet_3;
-extern vector<vector<bool>> grid_sprite_alphabet_4;
-extern vector<vector<bool>> grid_sprite_alphabet_5;
-extern vector<vector<bool>> grid_sprite_alphabet_6;
-extern vector<vector<bool>> grid_sprite_alphabet_7;
-extern vector<vector<bool>> grid_sprite_alphabet_8;
-extern vector<vector<bool>> grid_sprite_alphabet_9;
-vector<vector<bool>> get_gridsprite_number(int i);
\ No newline at end of file
+extern Grid grid_sprite_alphabet_0;
+extern Grid grid_sprite_alphabet_1;
+extern Grid grid_sprite_alphabet_2;
+extern Grid grid_sprite_alphabet_3;
+extern Grid grid_sprite_alphabet_4;
+extern Grid grid_sprite_alphabet_5;
+extern Grid grid_sprite_alphabet_6;
+extern Grid grid_sprite_alphabet_7;
+extern Grid grid_sprite_alphabet_8;
+extern Grid grid_sprite_alphabet_9;
+const Grid& get_gridsprite_number(int i);
\ No newline at end of file
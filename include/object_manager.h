@@ -3,6 +3,8 @@
 #define OBJ_H
 
 #include <game.h>
+#include <new>
+#include <utility>
 
 enum enum_directions {
 	direction_right,
@@ -32,11 +34,15 @@ class game_object
 {
 public:
 	game_object(BrickGameFramework& game_, int _x, int _y);
+	virtual ~game_object() = default;
 	virtual void step_function();
 	virtual void draw_function();
 	virtual void destroy_function();
+	// Queues this instance for removal at the next apply_object_updates
 	void instance_destroy();
 
+	BrickGameFramework& game;
+
 	double x;
 	double y;
 	static unsigned int object_index;
@@ -44,14 +50,17 @@ public:
 
 	int direction;
 
-	BrickGameFramework& game;
-	vector<point> tail;
-
-	vector<vector<bool>> sprite;
-
 	bool marked_for_destruction = false;
+	// Keeps stepping after the game stops running, for effects like the explosion
+	bool steps_when_stopped = false;
 
-	std::string name;
+	// Debug label only, lookups go by class
+	const char* name;
+
+	// Set by instance_create. Where this instance sits in objects and in its type list.
+	int type_id = -1;
+	unsigned int object_slot = 0;
+	unsigned int type_slot = 0;
 };
 
 class obj_explosion : public game_object
@@ -64,9 +73,133 @@ public:
 	double animation_percent;
 };
 
-game_object* get_object_by_name(std::string name);
-bool object_exists(std::string name);
+// Every live instance. Removal swaps the last one into the gap, so the order is
+// creation order only until something is destroyed.
+extern vector<game_object*> objects;
+// The same instances grouped by class, with the same swap-and-pop removal
+extern vector<vector<game_object*>> objects_by_type;
+
+// Storage for one object class: fixed-size slabs carved into slots, with freed slots
+// kept for reuse. Slabs never move, so an instance's address is its handle until it
+// is destroyed, and once a game has made as many instances as it ever has alive at
+// once, creating more allocates nothing.
+template <typename T>
+class object_pool
+{
+public:
+	static const unsigned int slab_size = 32;
+
+	template <typename... Args>
+	T* create(Args&&... args)
+	{
+		if (free_slots.empty())
+			add_slab();
+
+		void* slot = free_slots.back();
+		free_slots.pop_back();
+		return new (slot) T(std::forward<Args>(args)...);
+	}
+
+	void release(T* instance)
+	{
+		instance->~T();
+		free_slots.push_back(instance);
+	}
+
+private:
+	struct slab
+	{
+		alignas(T) unsigned char storage[slab_size][sizeof(T)];
+	};
 
-extern vector<std::unique_ptr<game_object>> objects;
+	void add_slab()
+	{
+		slabs.push_back(std::make_unique<slab>());
+		free_slots.reserve(slabs.size() * slab_size);
+		for (int i = slab_size - 1; i >= 0; i--)
+			free_slots.push_back(slabs.back()->storage[i]);
+	}
+
+	vector<std::unique_ptr<slab>> slabs;
+	vector<void*> free_slots;
+};
+
+template <typename T>
+object_pool<T>& pool_of()
+{
+	static object_pool<T> pool;
+	return pool;
+}
+
+template <typename T>
+void release_to_pool(game_object* instance)
+{
+	pool_of<T>().release(static_cast<T*>(instance));
+}
+
+// Small dense id per object class, handed out the first time the class is used,
+// along with how to give its instances back to the pool
+int register_object_type(void (*release)(game_object*));
+
+template <typename T>
+int object_type_id()
+{
+	static const int id = register_object_type(&release_to_pool<T>);
+	return id;
+}
+
+void register_instance(game_object* instance, int type_id);
+
+// Creates an instance in its class's pool and adds it to objects. Always create
+// objects through this so the type lookups below see them. Between
+// begin_object_updates and apply_object_updates the instance is only queued, it
+// isn't stepped or found until the updates are applied.
+template <typename T, typename... Args>
+T* instance_create(Args&&... args)
+{
+	T* instance = pool_of<T>().create(std::forward<Args>(args)...);
+	register_instance(instance, object_type_id<T>());
+	return instance;
+}
+
+// From here on objects and objects_by_type stay as they are, creates and destroys
+// are queued, so it's safe to walk the lists while objects step.
+void begin_object_updates();
+// Adds everything created since begin_object_updates, then runs destroy_function on
+// and frees everything destroyed since the last apply, all in one pass.
+void apply_object_updates();
+
+// A live instance of exactly class T, or NULL. Meant for classes with one instance.
+template <typename T>
+T* instance_find()
+{
+	unsigned int type_id = object_type_id<T>();
+	if (type_id < objects_by_type.size() && !objects_by_type[type_id].empty())
+		return static_cast<T*>(objects_by_type[type_id].front());
+	return NULL;
+}
+
+template <typename T>
+bool instance_exists()
+{
+	return instance_find<T>() != NULL;
+}
+
+// Calls function(T&) on every live instance of class T
+template <typename T, typename Function>
+void instance_for_each(Function function)
+{
+	unsigned int type_id = object_type_id<T>();
+	if (type_id >= objects_by_type.size())
+		return;
+
+	vector<game_object*>& instances = objects_by_type[type_id];
+	for (unsigned int i = 0; i < instances.size(); i++)
+		function(*static_cast<T*>(instances[i]));
+}
+
+// Removes every instance, queued ones included, without running destroy_function.
+// The pools keep their slabs.
+void instance_destroy_all();
 
 #endif
\ No newline at end of file
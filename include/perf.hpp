@@ -19,6 +19,7 @@ extern "C" {
 		char name[32];
 		float values[GRAPH_HISTORY_COUNT];
 		int head;
+		int font;
 	};
 	typedef struct PerfGraph PerfGraph;
 
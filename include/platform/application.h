@@ -0,0 +1,8 @@
+#pragma once
+
+// Base class the game's main loop derives from, picked per platform at build time
+#ifdef __SWITCH__
+#include <nanovg/framework/CApplication.h>
+#else
+#include <platform/pc/application_pc.h>
+#endif
@@ -0,0 +1,7 @@
+#pragma once
+
+bool init_audio();
+bool exit_audio();
+void play_sound(const char* sound_name);
+void set_music_enabled(bool enabled);
+void set_sounds_enabled(bool enabled);
@@ -1,29 +1,54 @@
 #pragma once
 #include <string>
+#include <grid.hpp>
 
 #define TEXT_ALIGN_LEFT 1
 #define TEXT_ALIGN_TOP 8
 
+// Handles handed out by the loaders. Resolve them once at load time and draw with
+// them every frame, the name based overloads look the resource up on every call.
+struct SpriteId
+{
+	int index = 0;
+	bool valid() const { return index != 0; }
+};
+
+struct FontId
+{
+	int index = -1;
+	bool valid() const { return index >= 0; }
+};
+
 void initialize_graphics(unsigned int width, unsigned int height);
-void load_sprite(std::string sprite_name, std::string filename);
+SpriteId load_sprite(std::string sprite_name, std::string filename);
+bool draw_sprite(float x, float y, float width, float height, SpriteId sprite);
 bool draw_sprite(float x, float y, float width, float height, std::string sprite_name);
-void load_fonts();
+// Draws a whole board of cells with cell_on / cell_off in a fixed number of fills, however big the grid
+void draw_cell_grid(float x, float y, float cell_width, float cell_height, const Grid& grid, SpriteId cell_on, SpriteId cell_off);
+FontId load_font(std::string font_name, std::string filename);
+void add_fallback_font(FontId font, FontId fallback);
 void exit_graphics();
 void push_graphics();
 void gfx_translate(float x, float y);
 void gfx_scale(float x, float y);
 void gfx_rotate(float angle);
 void pop_graphics();
+void set_font(FontId font);
 void set_font(std::string font_name);
 void set_font_size(float size);
 void set_text_align(int alignment);
 void draw_set_fill_color(unsigned char r, unsigned char g, unsigned char b, unsigned char a);
-void draw_text(float x, float y, std::string text);
-void draw_text_width(float x, float y, float line_break, std::string text);
+void draw_text(float x, float y, const char* text);
+void draw_text(float x, float y, const std::string& text);
+void draw_text_width(float x, float y, float line_break, const char* text);
+void draw_text_width(float x, float y, float line_break, const std::string& text);
 void gfx_start_frame();
 void gfx_end_frame();
+// When on (the default), a frame identical to the ones already in every framebuffer is presented without redrawing
+void gfx_set_reuse_unchanged_frames(bool reuse);
 void draw_rounded_rect(float x, float y, float w, float h, float radius, unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha);
 void draw_rect(float x, float y, float w, float h, unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha);
+void draw_set_font(FontId font);
 void draw_set_font(std::string fontname);
 void draw_set_font_size(float size);
 void draw_set_font_align(int align);
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+typedef uint64_t u64;
+
+// Stand-in for the deko3d framework's CApplication. There is no display to wait on,
+// so frames run back to back on a simulated 60 Hz clock.
+class CApplication
+{
+protected:
+	virtual bool onFrame(u64) { return true; }
+
+public:
+	CApplication();
+	virtual ~CApplication();
+
+	// Runs until onFrame returns false
+	void run();
+	// Runs at most frame_count frames, returns false once onFrame has asked to stop
+	bool run_frames(unsigned int frame_count);
+
+	static constexpr u64 frame_time_ns = 1000000000ULL / 60;
+
+private:
+	u64 time_ns;
+};
+
+// Folder settings and scores are kept in, ending in '/'. ./config/brickgame/ unless a
+// test or benchmark points it at a scratch folder of its own.
+void set_config_path_pc(const std::string& path);
+const std::string& config_path_pc();
@@ -0,0 +1,10 @@
+#pragma once
+
+// Silent backend, only counts what would have been played
+unsigned int sounds_played_pc();
+
+bool init_audio_pc();
+bool exit_audio_pc();
+void play_sound_pc(const char* sound_name);
+void set_music_enabled_pc(bool enabled);
+void set_sounds_enabled_pc(bool enabled);
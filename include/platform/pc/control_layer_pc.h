@@ -0,0 +1,60 @@
+#pragma once
+#include <functional>
+
+// Buttons as bits, for scripting input on the pc backend
+enum pc_button
+{
+	pc_button_up = 1 << 0,
+	pc_button_right = 1 << 1,
+	pc_button_down = 1 << 2,
+	pc_button_left = 1 << 3,
+	pc_button_A = 1 << 4,
+	pc_button_B = 1 << 5,
+	pc_button_X = 1 << 6,
+	pc_button_Y = 1 << 7,
+	pc_button_L = 1 << 8,
+	pc_button_R = 1 << 9,
+	pc_button_ZL = 1 << 10,
+	pc_button_ZR = 1 << 11,
+	pc_button_start = 1 << 12,
+	pc_button_select = 1 << 13
+};
+
+// The script is asked for the held buttons once per update_controller, with the update's number
+void set_input_script_pc(std::function<unsigned int(unsigned int frame)> script);
+// Holds exactly these buttons until changed, replaces any script
+void set_held_buttons_pc(unsigned int buttons);
+
+void init_controllers_pc();
+void update_controllers_pc();
+
+bool keyboard_check_right_pc();
+bool keyboard_check_up_pc();
+bool keyboard_check_left_pc();
+bool keyboard_check_down_pc();
+
+bool keyboard_check_L_pc();
+bool keyboard_check_R_pc();
+bool keyboard_check_ZL_pc();
+bool keyboard_check_ZR_pc();
+
+bool keyboard_check_A_pc();
+bool keyboard_check_B_pc();
+bool keyboard_check_X_pc();
+bool keyboard_check_Y_pc();
+
+bool keyboard_check_pressed_right_pc();
+bool keyboard_check_pressed_up_pc();
+bool keyboard_check_pressed_left_pc();
+bool keyboard_check_pressed_down_pc();
+
+bool keyboard_check_pressed_A_pc();
+bool keyboard_check_pressed_B_pc();
+bool keyboard_check_pressed_X_pc();
+bool keyboard_check_pressed_Y_pc();
+
+bool keyboard_check_pressed_L_pc();
+bool keyboard_check_pressed_R_pc();
+
+bool keyboard_check_pressed_start_pc();
+bool keyboard_check_pressed_select_pc();
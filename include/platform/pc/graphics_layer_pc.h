@@ -1,3 +1,77 @@
 #pragma once
+#include <string>
+#include <vector>
+#include <grid.hpp>
 
-void initialize_graphics_pc(unsigned int width, unsigned int height);
\ No newline at end of file
+// Headless backend: nothing is rasterised, every draw call of a frame is recorded
+// into a command list that profilers and tests can inspect afterwards.
+enum gfx_command_type_pc
+{
+	gfx_command_push,
+	gfx_command_pop,
+	gfx_command_translate,
+	gfx_command_scale,
+	gfx_command_rotate,
+	gfx_command_font,
+	gfx_command_font_size,
+	gfx_command_text_align,
+	gfx_command_fill_color,
+	gfx_command_text,
+	gfx_command_text_box,
+	gfx_command_sprite,
+	gfx_command_cell_grid,
+	gfx_command_rounded_rect,
+	gfx_command_rect
+};
+
+struct gfx_command_pc
+{
+	gfx_command_type_pc type;
+	// Positions, sizes, angles and radii in call order
+	float args[5];
+	// Sprite or font handle, the lit handle for cell grids, the alignment for text_align
+	int handle;
+	// Unlit handle for cell grids
+	int handle_off;
+	// Lit cell count for cell grids
+	int count;
+	unsigned char color[4];
+	// Offset into gfx_frame_text_pc() for text commands
+	unsigned int text_offset;
+};
+
+// Commands of the last frame that was presented with a redraw
+const std::vector<gfx_command_pc>& gfx_frame_commands_pc();
+const char* gfx_command_text_pc(const gfx_command_pc& command);
+unsigned int gfx_frames_presented_pc();
+unsigned int gfx_frames_redrawn_pc();
+
+void initialize_graphics_pc(unsigned int width, unsigned int height);
+int load_font_pc(std::string font_name, std::string font_path);
+void add_fallback_font_pc(int font_handle, int fallback_handle);
+void exit_graphics_pc();
+void push_graphics_pc();
+void gfx_translate_pc(float x, float y);
+void gfx_scale_pc(float x, float y);
+void gfx_rotate_pc(float angle);
+void pop_graphics_pc();
+void set_font_pc(std::string font_name);
+void set_font_pc(int font_handle);
+void set_font_size_pc(float size);
+void set_text_align_pc(int alignment);
+void draw_set_fill_color_pc(unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+void draw_text_pc(float x, float y, const char* text);
+void draw_text_width_pc(float x, float y, float line_break, const char* text);
+int load_sprite_pc(std::string sprite_name, std::string sprite_path);
+bool draw_sprite_pc(float x, float y, float width, float height, std::string sprite_name);
+bool draw_sprite_pc(float x, float y, float width, float height, int sprite_handle);
+void draw_cell_grid_pc(float x, float y, float cell_width, float cell_height, const Grid& grid, int cell_on, int cell_off);
+void gfx_start_frame_pc();
+void gfx_end_frame_pc(bool redraw);
+int gfx_framebuffer_count_pc();
+void draw_rounded_rect_pc(float x, float y, float w, float h, float radius, unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha);
+void draw_rect_pc(float x, float y, float w, float h, unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha);
+void draw_set_font_pc(std::string fontname);
+void draw_set_font_pc(int font_handle);
+void draw_set_font_size_pc(float size);
+void draw_set_font_align_pc(int align);
@@ -0,0 +1,13 @@
+#pragma once
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <map>
+#include <string>
+
+extern std::map<std::string, Mix_Chunk*> audio_files;
+
+bool init_audio_switch();
+bool exit_audio_switch();
+void play_sound_switch(const char* sound_name);
+void set_music_enabled_switch(bool enabled);
+void set_sounds_enabled_switch(bool enabled);
@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+
+// Logging that never blocks the frame. LOG_* formats into a slot of a fixed ring
+// buffer and returns, a background thread prints the slots in order. When the ring
+// is full the message is dropped and counted instead of waiting.
+//
+// Sites below LOG_MIN_LEVEL compile to nothing. The rest cost one load and a mask
+// test when their module is switched off at runtime.
+
+enum log_level
+{
+	log_level_trace,
+	log_level_debug,
+	log_level_info,
+	log_level_warn,
+	log_level_error,
+	log_level_none,
+};
+
+enum log_module
+{
+	log_core = 1 << 0,
+	log_objects = 1 << 1,
+	log_games = 1 << 2,
+	log_gfx = 1 << 3,
+	log_audio = 1 << 4,
+	log_io = 1 << 5,
+	log_all = 0xFFFF,
+};
+
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL log_level_debug
+#endif
+
+extern std::atomic<unsigned int> log_enabled_modules;
+extern std::atomic<int> log_runtime_level;
+
+#ifdef __GNUC__
+#define LOG_PRINTF_FORMAT __attribute__((format(printf, 3, 4)))
+#else
+#define LOG_PRINTF_FORMAT
+#endif
+
+void log_write(log_level level, log_module module, const char* format, ...) LOG_PRINTF_FORMAT;
+
+#define LOG(level, module, ...) \
+	do { \
+		if constexpr ((level) >= LOG_MIN_LEVEL) \
+			if ((level) >= log_runtime_level.load(std::memory_order_relaxed) && (log_enabled_modules.load(std::memory_order_relaxed) & (module))) \
+				log_write((level), (module), __VA_ARGS__); \
+	} while (0)
+
+#define LOG_TRACE(module, ...) LOG(log_level_trace, module, __VA_ARGS__)
+#define LOG_DEBUG(module, ...) LOG(log_level_debug, module, __VA_ARGS__)
+#define LOG_INFO(module, ...) LOG(log_level_info, module, __VA_ARGS__)
+#define LOG_WARN(module, ...) LOG(log_level_warn, module, __VA_ARGS__)
+#define LOG_ERROR(module, ...) LOG(log_level_error, module, __VA_ARGS__)
+
+void log_set_level(log_level level);
+void log_set_modules(unsigned int modules);
+
+// Starts the thread that prints the ring. Until it runs messages wait in the ring.
+void start_log_writer();
+// Prints whatever is left and stops the thread
+void stop_log_writer();
+// Prints everything queued so far on the calling thread
+void log_drain();
+unsigned long long log_dropped_count();
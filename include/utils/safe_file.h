@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+
+// Crash-safe whole-file saves. safe_write_file writes path.tmp, fsyncs it, moves the
+// current file to path.bak and renames the new one into place, so there is always a
+// complete copy on disk. A crc32 footer line is appended to the contents.
+//
+// Nothing here touches shared state, so saves can run on a worker thread.
+bool safe_write_file(const std::string& path, const std::string& contents);
+// Reads path, checking and stripping the footer. Falls back to path.bak when path is
+// missing or fails its checksum. Files written before the footer existed are accepted as is.
+bool safe_read_file(const std::string& path, std::string& contents);
+// Same as safe_read_file for one exact file, no fallback
+bool safe_read_single_file(const std::string& path, std::string& contents);
+unsigned int crc32(const std::string& data);
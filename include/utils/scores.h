@@ -1,7 +1,50 @@
 #pragma once
+#include <cstdint>
 #include <string>
 
+// One fixed-size record per game, saved as-is in scores.bin. Changing this layout
+// means bumping score_file_version in scores.cpp.
+struct score_record
+{
+	char name[24];
+	int64_t score;
+	int64_t highscore;
+	int64_t play_count;
+	int64_t first_played; // unix seconds, 0 when never played
+	int64_t last_played;
+	int64_t flags;
+};
+
+enum score_flags
+{
+	score_has_highscore = 1,
+};
+
+// Loads scores.bin, or imports the old scores.json the first time. Replaces every
+// record, so call it before any game ids are looked up.
 void read_scores();
 void save_scores();
-void scores_set_score_value(std::string category, std::string game, std::string value);
-std::string scores_get_score_value(std::string category, std::string key);
\ No newline at end of file
+// Setting a score only marks the scores dirty. The writer thread saves them when a
+// flush is requested or every flush_interval_seconds, whichever comes first.
+void start_score_writer(unsigned int flush_interval_seconds = 10);
+// Stops the writer thread and saves anything still pending
+void stop_score_writer();
+// Wakes the writer to save soon, saves right away when no writer is running
+void scores_request_flush();
+// Saves now on the calling thread if anything changed
+void scores_flush();
+
+// Index of the game's record, adding an empty one the first time a name is seen.
+// Look it up once and keep it, everything below is a plain array access.
+int scores_game_id(const std::string& name);
+void scores_set_score(int game_id, int64_t score);
+void scores_set_highscore(int game_id, int64_t highscore);
+// False when the game has never set a highscore
+bool scores_get_highscore(int game_id, int64_t& highscore);
+// Bumps the play count and the played timestamps
+void scores_record_play(int game_id);
+score_record scores_get_record(int game_id);
+
+// The old scores.json layout: {"game": {"score": "12", "highscore": "40"}, ...}
+bool scores_import_json(const std::string& path);
+bool scores_export_json(const std::string& path);
@@ -11,11 +11,38 @@ namespace fs = std::filesystem;
 
 extern nlohmann::json settings_json;
 
+// Settings the game reads while running, hydrated from settings.json by read_settings.
+// Read the fields directly. Change them through settings_set so the file gets rewritten.
+struct settings_cache
+{
+	bool debug = true;
+	bool music = true;
+	bool sound = true;
+	std::string last_seen_version = "";
+};
+
+extern settings_cache settings;
+
 ////////
 
 void init_settings();
 void read_settings();
 void save_settings();
+// Saves if anything changed since the last save
+void settings_flush();
+void settings_mark_dirty();
+
+template <typename T>
+void settings_set(T& field, const T& value)
+{
+	if (field != value)
+	{
+		field = value;
+		settings_mark_dirty();
+	}
+}
+
+// Untyped access by category and key, registered keys go through the cache
 void settings_set_value(std::string category, std::string key, std::string value);
 std::string settings_get_value(std::string category, std::string key);
-bool settings_get_value_true(std::string category, std::string key);
\ No newline at end of file
+bool settings_get_value_true(std::string category, std::string key);
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <array>
 #include <optional>
 #include <unistd.h>
@@ -6,11 +7,8 @@
 #include <grid.hpp>
 #include <vector>
 #include <game.h>
-#include <nanovg/framework/CMemPool.h>
-#include <nanovg/framework/CApplication.h>
-#include <switch/runtime/devices/socket.h>
 #include <grid_sprites.h>
-#include "audio.h"
+#include <platform/audio_layer.h>
 #include <utils/scores.h>
 #include <games/game_menu.h>
 #include <games/game_snake.h>
@@ -23,27 +21,13 @@
 #include <utils/settings.h>
 #include <platform/control_layer.h>
 #include <platform/graphics_layer.h>
+#include <utils/log.h>
 
 using namespace std;
 
 vector<std::unique_ptr<subgame>> game_list;
 
-static int nxlink_sock = -1;
-
-extern "C" void userAppInit(void)
-{
-	romfsInit();
-	socketInitialize(NULL);
-	nxlink_sock = nxlinkConnectToHost(true, true);
-}
-
-extern "C" void userAppExit(void)
-{
-	if (nxlink_sock != -1)
-		close(nxlink_sock);
-	socketExit();
-	romfsExit();
-}
+game_resources resources;
 
 BrickGameFramework::BrickGameFramework()
 {
@@ -52,23 +36,26 @@ BrickGameFramework::BrickGameFramework()
 	initGraph(&fps, GRAPH_RENDER_FPS, "Frame Time");
 
 	// Load Resources
-	load_sprite("spr_cell_selected", "romfs:/images/cell_selected.png");
-	load_sprite("spr_cell_unselected", "romfs:/images/cell_unselected.png");
+	resources.spr_cell_selected = load_sprite("spr_cell_selected", "romfs:/images/cell_selected.png");
+	resources.spr_cell_unselected = load_sprite("spr_cell_unselected", "romfs:/images/cell_unselected.png");
 
-	load_sprite("spr_page_blip_selected", "romfs:/images/page_blip_selected.png");
-	load_sprite("spr_page_blip_unselected", "romfs:/images/page_blip_unselected.png");
+	resources.spr_page_blip_selected = load_sprite("spr_page_blip_selected", "romfs:/images/page_blip_selected.png");
+	resources.spr_page_blip_unselected = load_sprite("spr_page_blip_unselected", "romfs:/images/page_blip_unselected.png");
 
-	for (int i = 0; i < 16; i++)
-	{
-		std::string num = std::to_string(i);
-		if (i < 10)
-			num = "0" + num;
-		load_sprite("spr_cells_" + num, "romfs:/images/cells_" + num + ".png");
-	}
+	resources.fnt_icons = load_font("icons", "romfs:/fonts/entypo.ttf");
+	resources.fnt_sans = load_font("sans", "romfs:/fonts/Roboto-Regular.ttf");
+	resources.fnt_sans_bold = load_font("sans-bold", "romfs:/fonts/Roboto-Bold.ttf");
+	resources.fnt_emoji = load_font("emoji", "romfs:/fonts/NotoEmoji-Regular.ttf");
+	resources.fnt_seg = load_font("seg", "romfs:/fonts/DSEG7Classic-Bold.ttf");
+	resources.fnt_minecraft = load_font("minecraft", "romfs:/fonts/Minecraft.ttf");
+	resources.fnt_kongtext = load_font("kongtext", "romfs:/fonts/kongtext-regular.ttf");
+	resources.fnt_vcrtext = load_font("vcrtext", "romfs:/fonts/VCR_OSD_MONO_1.ttf");
 
-	load_fonts();
+	add_fallback_font(resources.fnt_sans, resources.fnt_emoji);
+	add_fallback_font(resources.fnt_sans_bold, resources.fnt_emoji);
+	fps.font = resources.fnt_sans.index;
 
-	printf("Done loading\n");
+	LOG_INFO(log_core, "Done loading");
 
 	//
 
@@ -91,6 +78,9 @@ BrickGameFramework::BrickGameFramework()
 	game_list.push_back(std::make_unique<subgame_rowfill>(*this));
 	game_list.push_back(std::make_unique<subgame_rowsmash>(*this));
 	game_list.push_back(std::make_unique<subgame_HiOrLo>(*this));
+
+	for (auto& game : game_list)
+		game->score_id = scores_game_id(game->name);
 }
 
 BrickGameFramework::~BrickGameFramework()
@@ -98,7 +88,7 @@ BrickGameFramework::~BrickGameFramework()
 	exit_graphics();
 }
 
-void draw_grid(vector<vector<bool>> _grid, float _x, float _y, double cell_size)
+void draw_grid(const Grid& _grid, float _x, float _y, double cell_size)
 {
 	push_graphics();
 	float angle = 0;
@@ -114,53 +104,8 @@ void draw_grid(vector<vector<bool>> _grid, float _x, float _y, double cell_size)
 	int border_size = 5;
 
 	draw_rounded_rect(grid_offset_x - border_size, grid_offset_y - border_size, cell_width * draw_grid_width + border_size * 2, cell_height * draw_grid_height + border_size * 2, border_size, 0, 0, 0, 255);
-	draw_rect(grid_offset_x, grid_offset_y, cell_width * draw_grid_width, cell_height * draw_grid_height, 109, 120, 92, 255);
+	draw_cell_grid(grid_offset_x, grid_offset_y, cell_width, cell_height, _grid, resources.spr_cell_selected, resources.spr_cell_unselected);
 
-	for (int i = 0; i < draw_grid_width; i += 2)
-	{
-		for (int j = 0; j < draw_grid_height; j += 2)
-		{
-			float x = grid_offset_x + (i)*cell_width;
-			float y = grid_offset_y + (j)*cell_height;
-			bool ul = grid_get(_grid, i, j);
-			bool ur = grid_get(_grid, i + 1, j);
-			bool bl = grid_get(_grid, i, j + 1);
-			bool br = grid_get(_grid, i + 1, j + 1);
-			unsigned int pos = 1 * ul + 2 * ur + 4 * bl + 8 * br;
-			std::string num = std::to_string(pos);
-
-			if (pos < 10)
-				num = "0" + num;
-			if (i + 2 <= draw_grid_width && j + 2 <= draw_grid_height)
-			{
-				draw_sprite(x, y, cell_width * 2, cell_height * 2, "spr_cells_" + num);
-			}
-			else
-			{
-				if (i < draw_grid_width && j < draw_grid_height)
-				{
-					if (grid_get(_grid, i, j))
-						draw_sprite(x, y, cell_width, cell_height, "spr_cell_selected"); // 11% opacity
-					else
-						draw_sprite(x, y, cell_width, cell_height, "spr_cell_unselected");
-				}
-				if (i + 1 < draw_grid_width && j < draw_grid_height)
-				{
-					if (grid_get(_grid, i + 1, j))
-						draw_sprite(x + cell_width, y, cell_width, cell_height, "spr_cell_selected"); // 11% opacity
-					else
-						draw_sprite(x + cell_width, y, cell_width, cell_height, "spr_cell_unselected");
-				}
-				if (i < draw_grid_width && j + 1 < draw_grid_height)
-				{
-					if (grid_get(_grid, i, j + 1))
-						draw_sprite(x, y + cell_height, cell_width, cell_height, "spr_cell_selected"); // 11% opacity
-					else
-						draw_sprite(x, y + cell_height, cell_width, cell_height, "spr_cell_unselected");
-				}
-			}
-		}
-	}
 	pop_graphics();
 }
 
@@ -195,107 +140,37 @@ void renderGame(BrickGameFramework& game, float mx, float my, float t)
 	gfx_scale(scale, scale);
 	gfx_rotate(angle);
 
-	int cell_width = 31;
-	int cell_height = 31;
-
-	int draw_grid_width = grid_width(game.game_grid);
-	int draw_grid_height = grid_height(game.game_grid);
-
-	int grid_offset_x = (-(draw_grid_width * cell_width)) / 2.;
-	int grid_offset_y = (-(draw_grid_height * cell_height)) / 2.;
-
-	int border_size = 5;
-
-	draw_rounded_rect(grid_offset_x - border_size, grid_offset_y - border_size, cell_width * draw_grid_width + border_size * 2, cell_height * draw_grid_height + border_size * 2, border_size, 0, 0, 0, 255);
-	draw_rect(grid_offset_x, grid_offset_y, cell_width * draw_grid_width, cell_height * draw_grid_height, 109, 120, 92, 255);
-
-	for (int i = 0; i < draw_grid_width; i += 2)
-	{
-		for (int j = 0; j < draw_grid_height; j += 2)
-		{
-			float x = grid_offset_x + (i)*cell_width;
-			float y = grid_offset_y + (j)*cell_height;
-
-			bool ul = grid_get(game.game_grid, i, j);
-			bool ur = grid_get(game.game_grid, i + 1, j);
-			bool bl = grid_get(game.game_grid, i, j + 1);
-			bool br = grid_get(game.game_grid, i + 1, j + 1);
-
-			unsigned int pos = 1 * ul + 2 * ur + 4 * bl + 8 * br;
-
-			std::string num = std::to_string(pos);
-			if (pos < 10)
-				num = "0" + num;
-
-			if (i + 2 <= draw_grid_width && j + 2 <= draw_grid_height)
-			{
-				draw_sprite(x, y, cell_width * 2, cell_height * 2, "spr_cells_" + num);
-			}
-			else
-			{
-				if (i < draw_grid_width && j < draw_grid_height)
-				{
-					if (grid_get(game.game_grid, i, j))
-						draw_sprite(x, y, cell_width, cell_height, "spr_cell_selected"); // 11% opacity
-					else
-						draw_sprite(x, y, cell_width, cell_height, "spr_cell_unselected");
-				}
-
-				if (i + 1 < draw_grid_width && j < draw_grid_height)
-				{
-					if (grid_get(game.game_grid, i + 1, j))
-						draw_sprite(x + cell_width, y, cell_width, cell_height, "spr_cell_selected"); // 11% opacity
-					else
-						draw_sprite(x + cell_width, y, cell_width, cell_height, "spr_cell_unselected");
-				}
-
-				if (i < draw_grid_width && j + 1 < draw_grid_height)
-				{
-					if (grid_get(game.game_grid, i, j + 1))
-						draw_sprite(x, y + cell_height, cell_width, cell_height, "spr_cell_selected"); // 11% opacity
-					else
-						draw_sprite(x, y + cell_height, cell_width, cell_height, "spr_cell_unselected");
-				}
-			}
-
-			//if (grid_get(game.game_grid, i, j))
-			//	draw_sprite(vg, x, y, cell_width, cell_height, "spr_cell_selected"); // 11% opacity
-			//else
-			//	draw_sprite(vg, x, y, cell_width, cell_height, "spr_cell_unselected");
-		}
-	}
+	draw_grid(game.game_grid, 0, 0, 31);
 
 	pop_graphics();
 }
 
-void draw_digital_display(std::string display_string, int x, int y, std::string title, int angle = 0, unsigned int length = 8)
+void draw_digital_display(const std::string& display_string, int x, int y, const char* title, int angle = 0, unsigned int length = 8)
 {
 	push_graphics();
 	gfx_translate(x, y);
-	gfx_rotate(nvgDegToRad(angle));
+	gfx_rotate(DegToRad(angle));
 
-	set_font("kongtext");
+	set_font(resources.fnt_kongtext);
 	set_font_size(24);
 	set_text_align(TEXT_ALIGN_LEFT | TEXT_ALIGN_TOP);
 	draw_set_fill_color(0, 0, 0, 255);
-	draw_text(3, 0, title.c_str());
+	draw_text(3, 0, title);
 
-	set_font("seg");
+	set_font(resources.fnt_seg);
 	set_font_size(40);
 	set_text_align(TEXT_ALIGN_LEFT | TEXT_ALIGN_TOP);
 
-	std::string temp_score = display_string;
-
-	while (temp_score.size() < length)
-		temp_score = " " + temp_score;
+	// Right aligned, blank digits on the left
+	unsigned int padding = (display_string.size() < length) ? length - display_string.size() : 0;
 
 	for (unsigned int i = 0; i < length; i++)
 	{
 		draw_set_fill_color(97, 112, 91, 255);
 		draw_text((i * 30), 28, "8");
 		draw_set_fill_color(0, 0, 0, 255);
-		std::string charat(1, temp_score.at(i));
-		draw_text((i * 30), 28, charat.c_str());
+		char charat[2] = { (i < padding) ? ' ' : display_string.at(i - padding), '\0' };
+		draw_text((i * 30), 28, charat);
 	}
 
 	pop_graphics();
@@ -308,28 +183,28 @@ void BrickGameFramework::render(u64 ns)
 	prevTime = time;
 	updateGraph(&fps, dt);
 
-	gfx_start_frame();
+	renderGame(*this, 0, 0, time);
+
+	int wid = 8 * 30;
+	if (screen_orientation == orientation_normal)
 	{
-		renderGame(*this, 0, 0, time);
+		push_graphics();
+		gfx_translate(150, 80);
+		draw_set_font(resources.fnt_vcrtext);
+		draw_set_font_size(72);
+		draw_set_font_align(TEXT_ALIGN_LEFT | TEXT_ALIGN_TOP);
+		draw_set_fill_color(0, 0, 0, 255);
+		draw_text(3, 0, current_game_name);
+		pop_graphics();
 
-		int wid = 8 * 30;
-		if (screen_orientation == orientation_normal)
-		{
-			push_graphics();
-			gfx_translate(150, 80);
-			draw_set_font("vcrtext");
-			draw_set_font_size(72);
-			draw_set_font_align(TEXT_ALIGN_LEFT | TEXT_ALIGN_TOP);
-			draw_set_fill_color(0, 0, 0, 255);
-			draw_text(3, 0, current_game_name.c_str());
-			pop_graphics();
-
-			draw_digital_display(score_display, 865, 70, "Score");
-			draw_digital_display(highscore_display, 865, 165, "High Score");
+		draw_digital_display(score_display, 865, 70, "Score");
+		draw_digital_display(highscore_display, 865, 165, "High Score");
 
-			if (current_game != -1)
+		if (current_game != -1)
+		{
+			if (controls_text_game != current_game)
 			{
-				std::string controls_text = game_list.at(current_game)->subgame_controls_text();
+				controls_text = game_list.at(current_game)->subgame_controls_text();
 
 				std::string global_controls;
 				if (!controls_text.empty())
@@ -340,31 +215,30 @@ void BrickGameFramework::render(u64 ns)
 
 				controls_text = "Controls:\n\n" + controls_text;
 				controls_text += global_controls;
+				controls_text_game = current_game;
+			}
 
-				if (!controls_text.empty())
-				{
-					push_graphics();
-					gfx_translate(865, 475);
-					set_font("kongtext");
-					set_font_size(16);
-					draw_set_font_align(TEXT_ALIGN_LEFT | TEXT_ALIGN_TOP);
-					draw_set_fill_color(0, 0, 0, 255);
-					draw_text_width(3, 0, 1000, controls_text.c_str());
-					pop_graphics();
-				}
+			if (!controls_text.empty())
+			{
+				push_graphics();
+				gfx_translate(865, 475);
+				set_font(resources.fnt_kongtext);
+				set_font_size(16);
+				draw_set_font_align(TEXT_ALIGN_LEFT | TEXT_ALIGN_TOP);
+				draw_set_fill_color(0, 0, 0, 255);
+				draw_text_width(3, 0, 1000, controls_text);
+				pop_graphics();
 			}
 		}
-		else if (screen_orientation == orientation_left_down)
-		{
-			draw_digital_display(score_display, 1235, 720 / 2 - wid - 30, "Score", 90);
-			draw_digital_display(highscore_display, 1235, 720 / 2 + 30, "High Score", 90);
-		}
 	}
-
-	gfx_end_frame();
+	else if (screen_orientation == orientation_left_down)
+	{
+		draw_digital_display(score_display, 1235, 720 / 2 - wid - 30, "Score", 90);
+		draw_digital_display(highscore_display, 1235, 720 / 2 + 30, "High Score", 90);
+	}
 }
 
-void transition(std::vector<std::vector<bool>>& grid, double percent)
+void transition(Grid& grid, double percent)
 {
 	//printf("%f percent\n", percent);
 	if (percent > 0 && percent <= 100)
@@ -396,12 +270,69 @@ void BrickGameFramework::SwitchToGame(int i)
 	}
 }
 
-double fast_forwarder_half()
+bool BrickGameFramework::onFrame(u64 ns)
 {
-	return (1 - (.75 * fast_forward));
+	unsigned int scale = fast_forward ? fast_forward_scale : time_scale;
+
+	// The first frame, or a clock that went backwards, runs one tick and starts counting from here
+	if (!clock_started || ns < last_frame_ns)
+	{
+		clock_started = true;
+		tick_accumulator_ns = tick_ns * scale;
+	}
+	else
+	{
+		// A frame within 2% of one tick counts as exactly one, so vsync jitter doesn't
+		// turn into alternating frames of zero and two ticks
+		u64 elapsed = ns - last_frame_ns;
+		if (elapsed > tick_ns - tick_ns / 50 && elapsed < tick_ns + tick_ns / 50)
+			elapsed = tick_ns;
+		tick_accumulator_ns += elapsed * scale;
+	}
+	last_frame_ns = ns;
+
+	if (tick_accumulator_ns > tick_ns * max_ticks_per_frame * scale)
+		tick_accumulator_ns = tick_ns * max_ticks_per_frame * scale;
+
+	while (tick_accumulator_ns >= tick_ns)
+	{
+		tick_accumulator_ns -= tick_ns;
+		if (!step_frame())
+			return false;
+	}
+
+	tick_interpolation = (float)tick_accumulator_ns / tick_ns;
+
+	// Subgames also draw straight to the screen from subgame_draw (menu text, the Tetris
+	// preview), so the frame has to be open before the board is drawn into
+	gfx_start_frame();
+	draw_frame();
+	render(ns);
+	gfx_end_frame();
+
+	return true;
 }
 
-bool BrickGameFramework::onFrame(u64 ns)
+void BrickGameFramework::set_tick_rate(unsigned int ticks_per_second)
+{
+	tick_ns = 1000000000ULL / std::max(1u, ticks_per_second);
+	tick_accumulator_ns = 0;
+}
+
+unsigned int BrickGameFramework::tick_rate() const
+{
+	return 1000000000ULL / tick_ns;
+}
+
+bool BrickGameFramework::simulate_ticks(unsigned int tick_count)
+{
+	for (unsigned int i = 0; i < tick_count; i++)
+		if (!step_frame())
+			return false;
+	return true;
+}
+
+bool BrickGameFramework::step_frame()
 {
 	update_controller();
 
@@ -417,32 +348,14 @@ bool BrickGameFramework::onFrame(u64 ns)
 
 	if (keyboard_check_pressed_L())
 	{
-		if (settings_get_value_true("temp_prefs", "music_bool"))
-		{
-			Mix_VolumeMusic(0);
-			settings_set_value("temp_prefs", "music_bool", "false");
-		}
-		else
-		{
-			Mix_VolumeMusic(128);
-			settings_set_value("temp_prefs", "music_bool", "true");
-		}
+		settings_set(settings.music, !settings.music);
+		set_music_enabled(settings.music);
 	}
 
 	if (keyboard_check_pressed_R())
 	{
-		if (settings_get_value_true("temp_prefs", "sound_bool"))
-		{
-			for (auto const& [key, val] : audio_files)
-				Mix_VolumeChunk(val, 0);
-			settings_set_value("temp_prefs", "sound_bool", "false");
-		}
-		else
-		{
-			for (auto const& [key, val] : audio_files)
-				Mix_VolumeChunk(val, 32);
-			settings_set_value("temp_prefs", "sound_bool", "true");
-		}
+		settings_set(settings.sound, !settings.sound);
+		set_sounds_enabled(settings.sound);
 	}
 
 	if (grid_width(game_grid) < target_grid_width)
@@ -463,37 +376,22 @@ bool BrickGameFramework::onFrame(u64 ns)
 		game_grid = grid_create(grid_width(game_grid), grid_height(game_grid) - 1);
 	}
 
-	grid_clear(game_grid);
-
 	if (current_game != -1)
 	{
 		if (transition_stage == -1)
 		{
-			if (running)
-			{
-				for (unsigned int i = 0; i < objects.size(); i++)
-					objects.at(i)->step_function();
+			begin_object_updates();
 
-				game_list.at(current_game)->subgame_step();
-			}
-		}
+			// After a loss only objects like the explosion keep going
+			for (game_object* instance : objects)
+				if (running || instance->steps_when_stopped)
+					instance->step_function();
 
-		//
-		for (unsigned int i = 0; i < objects.size(); i++)
-		{
-			if (objects.at(i)->marked_for_destruction)
-			{
-				objects.at(i)->destroy_function();
-				objects.erase(objects.begin() + i);
-				i--;
-			}
+			if (running)
+				game_list.at(current_game)->subgame_step();
 		}
-		//
-
-		for (unsigned int i = 0; i < objects.size(); i++)
-			objects.at(i)->draw_function();
 
-		game_list.at(current_game)->subgame_draw();
+		apply_object_updates();
 	}
 
 	if ((next_game != -1 && next_game != current_game) && transition_stage == -1)
@@ -513,8 +411,10 @@ bool BrickGameFramework::onFrame(u64 ns)
 			transition_stage = 1;
 			if (current_game != -1)
 			{
-				objects.clear();
+				instance_destroy_all();
 				game_list.at(current_game)->subgame_exit();
+				scores_request_flush();
+				settings_flush();
 			}
 
 			current_game = next_game;
@@ -522,20 +422,23 @@ bool BrickGameFramework::onFrame(u64 ns)
 			running = true;
 
 			current_game_name = game_list.at(current_game)->name;
-			setScore(0);
-			highscore_display = scores_get_score_value(current_game_name, "highscore");
-			try
+			current_score_id = game_list.at(current_game)->score_id;
+			scores_record_play(current_score_id);
+
+			int64_t stored_highscore;
+			if (scores_get_highscore(current_score_id, stored_highscore))
 			{
-				highscore = stod(highscore_display);
+				highscore = stored_highscore;
+				highscore_display = std::to_string(stored_highscore);
 			}
-			catch (const std::invalid_argument& ia)
+			else
 			{
 				highscore = 0;
+				highscore_display = "---";
 			}
+			setScore(0);
 			game_list.at(current_game)->subgame_init();
 		}
-
-		transition(game_grid, transition_percent);
 	}
 	else if (transition_stage == 1)
 	{
@@ -548,23 +451,36 @@ bool BrickGameFramework::onFrame(u64 ns)
 			transition_percent = 0;
 			transition_stage = -1;
 		}
-
-		transition(game_grid, transition_percent);
 	}
 
 	if (keyboard_check_pressed_select())
 	{
 		screen_orientation += 1;
 		screen_orientation = screen_orientation % 4;
-		printf("orientation: %i\n", screen_orientation);
+		LOG_DEBUG(log_core, "orientation: %i", screen_orientation);
 	}
 
 	game_time_in_frames += 1;
 
-	render(ns);
 	return true;
 }
 
+void BrickGameFramework::draw_frame()
+{
+	grid_clear(game_grid);
+
+	if (current_game != -1)
+	{
+		for (game_object* instance : objects)
+			instance->draw_function();
+
+		game_list.at(current_game)->subgame_draw();
+	}
+
+	if (transition_stage != -1)
+		transition(game_grid, transition_percent);
+}
+
 void BrickGameFramework::setScoreDisplay(std::string score)
 {
 	score_display = score;
@@ -577,17 +493,7 @@ void BrickGameFramework::setHighScoreDisplay(std::string score)
 
 void BrickGameFramework::setScore(int _score)
 {
-	int hs = highscore;
-
-	if (_score > highscore)
-	{
-		hs = _score;
-		highscore = _score;
-		setHighScore(std::to_string(hs));
-	}
-
-	score = _score;
-	setScore(std::to_string(_score));
+	setScore((double)_score);
 }
 
 void BrickGameFramework::setScore(double _score)
@@ -595,17 +501,12 @@ void BrickGameFramework::setScore(double _score)
 	if (_score > highscore)
 	{
 		highscore = _score;
-		setHighScore(std::to_string(highscore));
+		setHighScore((int64_t)highscore);
 	}
 
 	score = _score;
-	setScore(std::to_string(_score));
-}
-
-void BrickGameFramework::setScore(std::string score)
-{
-	score_display = score;
-	scores_set_score_value(current_game_name, "score", score);
+	score_display = std::to_string((int64_t)_score);
+	scores_set_score(current_score_id, (int64_t)_score);
 }
 
 void BrickGameFramework::incrementScore(int amount)
@@ -613,27 +514,9 @@ void BrickGameFramework::incrementScore(int amount)
 	setScore((int)score + amount);
 }
 
-void BrickGameFramework::setHighScore(std::string score)
+void BrickGameFramework::setHighScore(int64_t score)
 {
-	highscore_display = score;
-	scores_set_score_value(current_game_name, "highscore", score);
+	highscore_display = std::to_string(score);
+	scores_set_highscore(current_score_id, score);
+	scores_request_flush();
 }
-
-int main(int argc, char* argv[])
-{
-	read_settings();
-	init_settings();
-
-	init_audio();
-
-	read_scores();
-
-	fast_forward = false;
-	srand(time(NULL));
-
-	BrickGameFramework app;
-	app.run();
-
-	exit_audio();
-	return 0;
-}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <grid_sprites_numbers.h>
 #include <utils.hpp>
 #include <platform/control_layer.h>
+#include <utils/log.h>
 
 subgame_HiOrLo::subgame_HiOrLo(BrickGameFramework& _parent) : subgame(_parent)
 {
@@ -20,7 +21,7 @@ int subgame_HiOrLo::get_next_num()
 void subgame_HiOrLo::subgame_init()
 {
 	if (game.debug_text)
-		printf("Initting HiOrLo!!\n");
+		LOG_DEBUG(log_games, "Initting HiOrLo!!");
 
 	current_number = 5;
 	next_number = get_next_num();
@@ -33,12 +34,12 @@ void subgame_HiOrLo::subgame_step()
 		if (next_number > current_number)
 		{
 			game.incrementScore(1);
-			objects.push_back(std::make_unique<obj_check>(game, 3, 1));
+			instance_create<obj_check>(game, 3, 1);
 		}
 		else
 		{
 			game.incrementScore(-1);
-			objects.push_back(std::make_unique<obj_x>(game, 3, 1));
+			instance_create<obj_x>(game, 3, 1);
 		}
 	}
 
@@ -47,12 +48,12 @@ void subgame_HiOrLo::subgame_step()
 		if (next_number < current_number)
 		{
 			game.incrementScore(1);
-			objects.push_back(std::make_unique<obj_check>(game, 3, 14));
+			instance_create<obj_check>(game, 3, 14);
 		}
 		else
 		{
 			game.incrementScore(-1);
-			objects.push_back(std::make_unique<obj_x>(game, 3, 14));
+			instance_create<obj_x>(game, 3, 14);
 		}
 	}
 
@@ -61,14 +62,14 @@ void subgame_HiOrLo::subgame_step()
 		if (next_number == current_number)
 		{
 			game.incrementScore(5);
-			objects.push_back(std::make_unique<obj_check>(game, 3, 1));
-			objects.push_back(std::make_unique<obj_check>(game, 3, 14));
+			instance_create<obj_check>(game, 3, 1);
+			instance_create<obj_check>(game, 3, 14);
 		}
 		else
 		{
 			game.incrementScore(-5);
-			objects.push_back(std::make_unique<obj_x>(game, 3, 1));
-			objects.push_back(std::make_unique<obj_x>(game, 3, 14));
+			instance_create<obj_x>(game, 3, 1);
+			instance_create<obj_x>(game, 3, 14);
 		}
 	}
 
@@ -81,7 +82,7 @@ void subgame_HiOrLo::subgame_step()
 
 void subgame_HiOrLo::subgame_draw()
 {
-	vector<vector<bool>> spr = get_gridsprite_number(current_number);
+	const Grid& spr = get_gridsprite_number(current_number);
 	place_grid_sprite(game.game_grid, spr, 4, 7);
 
 }
@@ -89,7 +90,7 @@ void subgame_HiOrLo::subgame_draw()
 void subgame_HiOrLo::subgame_exit()
 {
 	if (game.debug_text)
-		printf("Exiting HiOrLo!!\n");
+		LOG_DEBUG(log_games, "Exiting HiOrLo!!");
 }
 
 std::string subgame_HiOrLo::subgame_controls_text()
@@ -111,7 +112,7 @@ void subgame_HiOrLo::obj_check::step_function()
 
 void subgame_HiOrLo::obj_check::draw_function()
 {
-	vector<vector<bool>> grid_sprite_check
+	Grid grid_sprite_check
 	{
 		{ 0, 0, 0, 0, 1 },
 		{ 0, 0, 0, 1, 0 },
@@ -141,7 +142,7 @@ void subgame_HiOrLo::obj_x::step_function()
 
 void subgame_HiOrLo::obj_x::draw_function()
 {
-	vector<vector<bool>> grid_sprite_check
+	Grid grid_sprite_check
 	{
 		{ 1, 0, 0, 0, 1 },
 		{ 0, 1, 0, 1, 0 },
@@ -11,26 +11,30 @@
 #include <utils/scores.h>
 #include <platform/control_layer.h>
 #include <platform/graphics_layer.h>
+#include <utils/log.h>
 
 subgame_menu::subgame_menu(BrickGameFramework& _parent) : subgame(_parent)
 {
 	name = "Menu";
 }
 
+void subgame_menu::show_selected_highscore()
+{
+	int64_t highscore;
+	if (scores_get_highscore(game_list.at(selected_game)->score_id, highscore))
+		game.setHighScoreDisplay(std::to_string(highscore));
+	else
+		game.setHighScoreDisplay("---");
+}
+
 void subgame_menu::subgame_init()
 {
 	if (game.debug_text)
-		printf("Initting Menu!!\n");
-	objects.push_back(std::make_unique<obj_border>(game, this));
+		LOG_DEBUG(log_games, "Initting Menu!!");
+	instance_create<obj_border>(game, this);
 	game.setScoreDisplay("---");
 
-	try {
-		game.setHighScoreDisplay(scores_get_score_value(game_list.at(selected_game)->name, "highscore"));
-	}
-	catch (exception& e)
-	{
-		game.setHighScoreDisplay("---");
-	}
+	show_selected_highscore();
 }
 
 void subgame_menu::subgame_step()
@@ -48,7 +52,7 @@ void subgame_menu::subgame_step()
 	if (selected_game < 0)
 		selected_game += game_list.size();
 
-	if (selected_game >= game_list.size())
+	if (selected_game >= (int)game_list.size())
 	{
 		selected_game -= game_list.size();
 	}
@@ -56,13 +60,7 @@ void subgame_menu::subgame_step()
 	if (keyboard_check_pressed_left() || keyboard_check_pressed_right())
 	{
 		game.setScoreDisplay("---");
-		try {
-			game.setHighScoreDisplay(scores_get_score_value(game_list.at(selected_game)->name, "highscore"));
-		}
-		catch (exception& e)
-		{
-			game.setHighScoreDisplay("---");
-		}
+		show_selected_highscore();
 	}
 
 	if (keyboard_check_pressed_A())
@@ -81,28 +79,28 @@ void subgame_menu::subgame_draw()
 	push_graphics();
 	gfx_translate(165, 144);
 
-	set_font("vcrtext");
+	set_font(resources.fnt_vcrtext);
 	set_font_size(48);
-	set_text_align(NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+	set_text_align(TEXT_ALIGN_LEFT | TEXT_ALIGN_TOP);
 	draw_set_fill_color(0, 0, 0, 255);
 	draw_text(3, 0, game_list.at(selected_game)->name);
 	pop_graphics();
 
-	for (int i = 0; i < game_list.size(); i++)
+	for (int i = 0; i < (int)game_list.size(); i++)
 	{
 		int size = 15;
 		int xx = (1280 / 2) - (game_list.size() * (size + 15) / 2) + (i * (size + 15)) - 10;
 		if (i == selected_game)
-			draw_sprite(xx, 720 - 30, size, size, "spr_page_blip_selected");
+			draw_sprite(xx, 720 - 30, size, size, resources.spr_page_blip_selected);
 		else
-			draw_sprite(xx, 720 - 30, size, size, "spr_page_blip_unselected");
+			draw_sprite(xx, 720 - 30, size, size, resources.spr_page_blip_unselected);
 	}
 }
 
 void subgame_menu::subgame_exit()
 {
 	if (game.debug_text)
-		printf("Exiting Menu!!\n");
+		LOG_DEBUG(log_games, "Exiting Menu!!");
 }
 
 void subgame_menu::subgame_demo()
@@ -198,7 +196,7 @@ void subgame_menu::obj_welcome_text::step_function()
 {
 	if (x > -40)
 	{
-		x -= (1. / 15) * (2 - fast_forwarder_half());
+		x -= 1. / 15;
 	}
 	else
 	{
@@ -6,16 +6,16 @@ bool paddle_is_at(int x, int y)
 {
 	int paddle_width = 2;
 
-	for (unsigned int j = 0; j < objects.size(); j++)
-	{
-		if (objects.at(j)->name == "obj_paddle")
+	bool found = false;
+	instance_for_each<subgame_pong::obj_paddle>([&](subgame_pong::obj_paddle& paddle)
+		{
 			for (int i = -paddle_width; i < paddle_width; i++)
 			{
-				if (x == objects.at(j)->x + i && y == objects.at(j)->y)
-					return true;
+				if (x == paddle.x + i && y == paddle.y)
+					found = true;
 			}
-	}
-	return false;
+		});
+	return found;
 }
 
 subgame_pong::obj_ball::obj_ball(BrickGameFramework& game, int _x, int _y) : game_object(game, _x, _y)
@@ -44,7 +44,7 @@ void subgame_pong::obj_ball::step_function()
 	}
 	else
 	{
-		time_til_move = pause_time * fast_forwarder_half();
+		time_til_move = pause_time;
 
 		if (x + hspeed < 0)
 		{
@@ -69,14 +69,14 @@ void subgame_pong::obj_ball::step_function()
 	{
 		game.incrementScore(-1);
 		instance_destroy();
-		objects.push_back(std::make_unique<obj_ball>(game, grid_width(game.game_grid) / 2, grid_height(game.game_grid) / 2));
+		instance_create<obj_ball>(game, grid_width(game.game_grid) / 2, grid_height(game.game_grid) / 2);
 	}
 
 	if (y < -2)
 	{
 		game.incrementScore(1);
 		instance_destroy();
-		objects.push_back(std::make_unique<obj_ball>(game, grid_width(game.game_grid) / 2, grid_height(game.game_grid) / 2));
+		instance_create<obj_ball>(game, grid_width(game.game_grid) / 2, grid_height(game.game_grid) / 2);
 	}
 }
 
@@ -97,9 +97,9 @@ subgame_pong::subgame_pong(BrickGameFramework& _parent) : subgame(_parent)
 
 void subgame_pong::subgame_init()
 {
-	objects.push_back(std::make_unique<obj_ball>(game, grid_width(game.game_grid) / 2, grid_height(game.game_grid) / 2));
-	objects.push_back(std::make_unique<obj_paddle>(game, grid_width(game.game_grid) / 2, grid_height(game.game_grid) - 1, false));
-	objects.push_back(std::make_unique<obj_paddle>(game, grid_width(game.game_grid) / 2, 0, true));
+	instance_create<obj_ball>(game, grid_width(game.game_grid) / 2, grid_height(game.game_grid) / 2);
+	instance_create<obj_paddle>(game, grid_width(game.game_grid) / 2, grid_height(game.game_grid) - 1, false);
+	instance_create<obj_paddle>(game, grid_width(game.game_grid) / 2, 0, true);
 }
 
 void subgame_pong::subgame_step()
@@ -163,7 +163,7 @@ void subgame_pong::obj_paddle::step_function()
 		if (keyboard_check_left() || keyboard_check_right())
 		{
 			if (time_til_move <= 0)
-				time_til_move = pause_time * fast_forwarder_half();
+				time_til_move = pause_time;
 			else
 				time_til_move -= 1;
 		}
@@ -172,14 +172,11 @@ void subgame_pong::obj_paddle::step_function()
 	{
 		int ball_x = -1;
 		int ball_y = -1;
-		for (unsigned int j = 0; j < objects.size(); j++)
-		{
-			if (objects.at(j)->name == "obj_ball")
+		instance_for_each<obj_ball>([&](obj_ball& ball)
 			{
-				ball_x = objects.at(j)->x;
-				ball_y = objects.at(j)->y;
-			}
-		}
+				ball_x = ball.x;
+				ball_y = ball.y;
+			});
 
 		bool left = (x > ball_x);
 		bool right = (x < ball_x);
@@ -205,7 +202,7 @@ void subgame_pong::obj_paddle::step_function()
 			if (left || right)
 			{
 				if (time_til_move <= 0)
-					time_til_move = pause_time * 2 * fast_forwarder_half();
+					time_til_move = pause_time * 2;
 				else
 					time_til_move -= 1;
 			}
@@ -3,10 +3,11 @@
 #include <grid_sprites.h>
 #include <algorithm>
 #include <platform/control_layer.h>
+#include <utils/log.h>
 
 using namespace std;
 
-vector<vector<bool>> grid_sprite_racecar
+Grid grid_sprite_racecar
 {
 	{ 0, 1, 0 },
 	{ 1, 1, 1 },
@@ -62,7 +63,7 @@ void subgame_race::obj_player_car::step_function()
 	if (keyboard_check_left() || keyboard_check_right() || keyboard_check_up() || keyboard_check_down())
 	{
 		if (time_til_move <= 0)
-			time_til_move = 5 * fast_forwarder_half();
+			time_til_move = 5;
 		else
 			time_til_move -= 1;
 	}
@@ -74,17 +75,15 @@ void subgame_race::obj_player_car::step_function()
 
 	//
 
-	for (unsigned int i = 0; i < objects.size(); i++)
-	{
-		if (objects.at(i)->name == "obj_player_ai")
+	bool crashed = false;
+	instance_for_each<obj_player_ai>([&](obj_player_ai& ai)
 		{
-			if (abs(objects.at(i)->x - x) <= 2 && abs(objects.at(i)->y - y) <= 3)
-			{
-				die();
-				break;
-			}
-		}
-	}
+			if (abs(ai.x - x) <= 2 && abs(ai.y - y) <= 3)
+				crashed = true;
+		});
+
+	if (crashed)
+		die();
 }
 
 void subgame_race::obj_player_car::draw_function()
@@ -100,7 +99,7 @@ void subgame_race::obj_player_car::destroy_function()
 void subgame_race::obj_player_car::die()
 {
 	game.running = false;
-	objects.push_back(std::make_unique<obj_explosion>(game, x, y));
+	instance_create<obj_explosion>(game, x, y);
 }
 
 subgame_race::subgame_race(BrickGameFramework& _parent) : subgame(_parent)
@@ -115,7 +114,7 @@ subgame_race::obj_border::obj_border(BrickGameFramework& game, int _x, int _y) :
 
 void subgame_race::obj_border::step_function()
 {
-	ticker += .15 * (2 - fast_forwarder_half());
+	ticker += .15;
 }
 
 void subgame_race::obj_border::draw_function()
@@ -135,23 +134,23 @@ void subgame_race::obj_border::destroy_function()
 
 void subgame_race::subgame_init()
 {
-	printf("Initting Race!!\n");
-	objects.push_back(std::make_unique<obj_border>(game, 0, 0));
-	objects.push_back(std::make_unique<obj_player_car>(game, 5, 15));
+	LOG_DEBUG(log_games, "Initting Race!!");
+	instance_create<obj_border>(game, 0, 0);
+	instance_create<obj_player_car>(game, 5, 15);
 }
 
 void subgame_race::subgame_step()
 {
 	if (time_til_spawn <= 0)
 	{
-		time_til_spawn = pause_time * fast_forwarder_half();
+		time_til_spawn = pause_time;
 		const int lane_width = 3;
 		int lane = rand() % ((grid_width(game.game_grid) - 2) / lane_width);
 		lane = lane * lane_width + 2 + 1;
 		lane = clamp((int)lane, 2, grid_width(game.game_grid) - 3 - 1);
 
-		printf("lane: %i\n", lane);
-		objects.push_back(std::make_unique<obj_player_ai>(game, lane, -5));
+		LOG_TRACE(log_games, "lane: %i", lane);
+		instance_create<obj_player_ai>(game, lane, -5);
 	}
 	else
 		time_til_spawn -= 1;
@@ -186,7 +185,7 @@ void subgame_race::obj_player_ai::step_function()
 {
 	if (time_til_move <= 0)
 	{
-		time_til_move = pause_time * fast_forwarder_half();
+		time_til_move = pause_time;
 		if (y < grid_height(game.game_grid))
 		{
 			y += 1;
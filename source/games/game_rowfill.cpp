@@ -2,8 +2,10 @@
 #include <game.h>
 #include <games/game_rowfill.h>
 #include <grid_sprites.h>
+#include <grid_rows.hpp>
 #include <algorithm>
 #include <platform/control_layer.h>
+#include <utils/log.h>
 
 subgame_rowfill::subgame_rowfill(BrickGameFramework& _parent) : subgame(_parent)
 {
@@ -12,8 +14,8 @@ subgame_rowfill::subgame_rowfill(BrickGameFramework& _parent) : subgame(_parent)
 
 void subgame_rowfill::subgame_init()
 {
-	objects.push_back(std::make_unique<obj_rows>(game, 3));
-	objects.push_back(std::make_unique<obj_player>(game, grid_width(game.game_grid) / 2, grid_height(game.game_grid) - 1));
+	instance_create<obj_rows>(game, 3);
+	instance_create<obj_player>(game, grid_width(game.game_grid) / 2, grid_height(game.game_grid) - 1);
 }
 
 void subgame_rowfill::subgame_step()
@@ -27,7 +29,7 @@ void subgame_rowfill::subgame_draw()
 void subgame_rowfill::subgame_exit()
 {
 	if (game.debug_text)
-		printf("Exiting Template!!\n");
+		LOG_DEBUG(log_games, "Exiting Template!!");
 }
 
 std::string subgame_rowfill::subgame_controls_text()
@@ -40,25 +42,15 @@ std::string subgame_rowfill::subgame_controls_text()
 void subgame_rowfill::obj_rows::lose()
 {
 	game.running = false;
-	objects.push_back(std::make_unique<obj_explosion>(game, grid_width(filled_blocks) / 2, grid_height(filled_blocks)));
+	instance_create<obj_explosion>(game, grid_width(filled_blocks) / 2, grid_height(filled_blocks));
 }
 
-int subgame_rowfill::obj_rows::lowest_occupied_line(std::vector<std::vector<bool>>& grid)
+int subgame_rowfill::obj_rows::lowest_occupied_line(Grid& grid)
 {
-	for (int i = grid_height(grid); i >= 0; i--)
-	{
-		for (int j = 0; j < grid_width(grid); j++)
-		{
-			if (grid_get(grid, j, i))
-			{
-				return i;
-			}
-		}
-	}
-	return 0;
+	return max(0, lowest_occupied_row(grid));
 }
 
-void subgame_rowfill::obj_rows::generate_row(std::vector<std::vector<bool>>& grid, int row_num)
+void subgame_rowfill::obj_rows::generate_row(Grid& grid, int row_num)
 {
 	for (int i = 0; i < grid_width(grid); i++)
 	{
@@ -80,13 +72,7 @@ subgame_rowfill::obj_rows::obj_rows(BrickGameFramework& game, int starting_rows)
 
 void subgame_rowfill::obj_rows::shift_down()
 {
-	for (int yy = grid_height(filled_blocks); yy > 0; yy--)
-	{
-		for (int xx = 0; xx < grid_width(filled_blocks); xx++)
-		{
-			grid_set(filled_blocks, xx, yy, grid_get(filled_blocks, xx, yy - 1));
-		}
-	}
+	shift_down_from(filled_blocks, grid_height(filled_blocks) - 1);
 
 	generate_row(filled_blocks, 0);
 
@@ -98,31 +84,12 @@ void subgame_rowfill::obj_rows::shift_down()
 
 void subgame_rowfill::obj_rows::check_rows()
 {
-	for (int iii = 0; iii < grid_height(filled_blocks); iii++)
+	// Full rows are removed and everything below them moves up towards the top
+	uint64_t full_rows = row_full_mask(filled_blocks);
+	if (full_rows != 0)
 	{
-		bool any_not_seen = false;
-		for (int i = 0; i < grid_width(filled_blocks); i++)
-		{
-			if (!grid_get(filled_blocks, i, iii))
-			{
-				any_not_seen = true;
-				break;
-			}
-		}
-
-		if (!any_not_seen)
-		{
-			for (int jjj = iii; jjj < grid_height(filled_blocks) - 1; jjj++)
-			{
-				for (int j = 0; j < grid_width(filled_blocks); j++)
-				{
-					grid_set(filled_blocks, j, jjj, grid_get(filled_blocks, j, jjj + 1));
-				}
-			}
-
-			game.incrementScore(1);
-			iii = -1;
-		}
+		int cleared = collapse_rows(filled_blocks, full_rows, true);
+		game.incrementScore(cleared);
 	}
 
 	if (lowest_occupied_line(filled_blocks) > grid_height(filled_blocks) - 4)
@@ -185,7 +152,7 @@ void subgame_rowfill::obj_player::step_function()
 	if (keyboard_check_left() || keyboard_check_right())
 	{
 		if (time_til_move <= 0)
-			time_til_move = pause_time;// *fast_forwarder_half();
+			time_til_move = pause_time;
 		else
 			time_til_move -= 1;
 	}
@@ -205,7 +172,7 @@ void subgame_rowfill::obj_player::step_function()
 		{
 			time_til_shoot = shoot_delay;
 			// shoot!
-			objects.push_back(std::make_unique<obj_bullet>(game, x, y));
+			instance_create<obj_bullet>(game, x, y);
 		}
 	}
 }
@@ -239,10 +206,9 @@ void subgame_rowfill::obj_bullet::step_function()
 	}
 	else
 	{
-		game_object* obj = get_object_by_name("obj_rows");
-		if (obj != NULL)
+		obj_rows* row_obj = instance_find<obj_rows>();
+		if (row_obj != NULL)
 		{
-			obj_rows* row_obj = static_cast<obj_rows*>(obj);
 
 			if (y == 0)
 			{
@@ -5,15 +5,15 @@
 #include <memory>
 #include <object_manager.h>
 #include <games/game_snake.h>
-#include "audio.h"
+#include <platform/audio_layer.h>
 #include <platform/control_layer.h>
+#include <utils/log.h>
 using namespace std;
 
 // Runs for each instance of a snake object once when it's created
 subgame_snake::obj_snake::obj_snake(BrickGameFramework& game, int _x, int _y) : game_object(game, _x, _y)
 {
-	printf("ID: %u\n", id);
-	printf("Snake create\n");
+	LOG_TRACE(log_objects, "Snake create %u", id);
 
 	move_counter = 0;
 	snake_length = 3;
@@ -48,9 +48,9 @@ bool subgame_snake::obj_snake::snake_is_at(int _x, int _y)
 void subgame_snake::obj_snake::die()
 {
 	alive = false;
-	Mix_PlayChannel(-1, audio_files["sfx_exp_odd3"], 0);
+	play_sound("sfx_exp_odd3");
 
-	printf("DIED!\n");
+	LOG_DEBUG(log_games, "DIED!");
 }
 
 // Runs for each instance of a snake object each frame
@@ -72,7 +72,7 @@ void subgame_snake::obj_snake::step_function()
 			snake_length += 1;
 			game.setScore(snake_length - 3);
 			time_til_move = max(10, time_til_move - 2);
-			Mix_PlayChannel(-1, audio_files["sfx_sounds_button6"], 0);
+			play_sound("sfx_sounds_button6");
 		}
 
 		if (keyboard_check_right() && last_direction != direction_left)
@@ -87,13 +87,13 @@ void subgame_snake::obj_snake::step_function()
 		if (keyboard_check_down() && last_direction != direction_up)
 			direction = direction_down;
 
-		if (move_counter < time_til_move * fast_forwarder_half())
+		if (move_counter < time_til_move)
 		{
 			move_counter += 1;
 		}
 		else
 		{
-			Mix_PlayChannel(-1, audio_files["sfx_movement_footsteps5"], 0);
+			play_sound("sfx_movement_footsteps5");
 			move_counter = 0;
 
 			tail.push_back(point(x, y));
@@ -137,7 +137,7 @@ void subgame_snake::obj_snake::step_function()
 			}
 			break;
 			default:
-				printf("No direction set\n");
+				LOG_WARN(log_games, "No direction set");
 			}
 
 			last_direction = direction;
@@ -166,8 +166,7 @@ void subgame_snake::obj_snake::draw_function()
 // To delete this instance of a snake from the game
 void subgame_snake::obj_snake::destroy_function()
 {
-	printf("ID: %u\n", id);
-	printf("Snake destroy\n");
+	LOG_TRACE(log_objects, "Snake destroy %u", id);
 };
 
 // Let's the subgame know what main game it belongs to.
@@ -179,9 +178,9 @@ subgame_snake::subgame_snake(BrickGameFramework& _parent) : subgame(_parent)
 // Runs once when the subgame starts (when the transition shade is fully black)
 void subgame_snake::subgame_init()
 {
-	printf("Initting Snake!!\n");
+	LOG_DEBUG(log_games, "Initting Snake!!");
 	// Create an instance of a snake object in game 'game' at position 5, 5.
-	objects.push_back(std::make_unique<obj_snake>(game, 5, 5));
+	instance_create<obj_snake>(game, 5, 5);
 }
 
 // Runs every frame of the subgame unless the game is transitioning
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <game.h>
 #include <games/game_template.h>
+#include <utils/log.h>
 
 subgame_template::subgame_template(BrickGameFramework& _parent) : subgame(_parent)
 {
@@ -10,7 +11,7 @@ subgame_template::subgame_template(BrickGameFramework& _parent) : subgame(_paren
 void subgame_template::subgame_init()
 {
 	if (game.debug_text)
-		printf("Initting Template!!\n");
+		LOG_DEBUG(log_games, "Initting Template!!");
 }
 
 void subgame_template::subgame_step()
@@ -24,7 +25,7 @@ void subgame_template::subgame_draw()
 void subgame_template::subgame_exit()
 {
 	if (game.debug_text)
-		printf("Exiting Template!!\n");
+		LOG_DEBUG(log_games, "Exiting Template!!");
 }
 
 std::string subgame_template::subgame_controls_text()
@@ -1,8 +1,11 @@
+#include <algorithm>
+#include <climits>
 #include <games/game_tetris.h>
 #include <games/game_race.h>
 #include <grid_sprites.h>
-#include <game_tetris_shapes.h>
+#include <grid_rows.hpp>
 #include <platform/control_layer.h>
+#include <utils/log.h>
 
 // Let's the subgame know what main game it belongs to.
 subgame_tetris::subgame_tetris(BrickGameFramework& _parent) : subgame(_parent)
@@ -13,9 +16,15 @@ subgame_tetris::subgame_tetris(BrickGameFramework& _parent) : subgame(_parent)
 // Runs once when the subgame starts (when the transition shade is fully black)
 void subgame_tetris::subgame_init()
 {
-	printf("Initting Tetris!!\n");
+	LOG_DEBUG(log_games, "Initting Tetris!!");
+	lines_cleared = 0;
+
+	uint64_t game_seed = (seed != 0) ? seed : ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+	pieces.reset(game_seed, randomizer);
+	build_preview();
+	LOG_INFO(log_games, "Tetris seed %llu", (unsigned long long)game_seed);
 	// Create an instance of a snake object in game 'game' at position 5, 5.
-	objects.push_back(std::make_unique<obj_tetris_rows>(game));
+	instance_create<obj_tetris_rows>(game);
 }
 
 // Runs every frame of the subgame unless the game is transitioning
@@ -29,47 +38,32 @@ void subgame_tetris::subgame_step()
 	else if (phase == 0)
 	{
 		// Create Object
-		objects.push_back(std::make_unique<obj_tetromino>(game, grid_width(game.game_grid) / 2 - 1, -2, next_piece));
-		next_piece = rand() % tetris_shapes.size();
+		obj_tetromino* piece = instance_create<obj_tetromino>(game, grid_width(game.game_grid) / 2 - 1, -2, pieces.next());
+		piece->lock_delay = lock_delay;
+		piece->ghost = show_ghost;
+		if (autoplay && piece->rows != NULL)
+		{
+			piece->ai = true;
+			piece->target = tetris_find_best_placement(piece->rows->filled_blocks, piece->shape_index, pieces.peek(0), piece->x, piece->y, ai_weights);
+		}
 		phase = 1;
 	}
 	else if (phase == 1)
 	{
 		// Wait for no more object
-		if (!object_exists("obj_tetromino"))
+		if (!instance_exists<obj_tetromino>())
 		{
 			phase = 2;
 		}
 	}
 	else if (phase == 2)
 	{
-		highlighted_rows.clear();
+		highlighted_rows = 0;
 		// Check Rows
-		game_object* rows = get_object_by_name("obj_tetris_rows");
-		if (rows != NULL)
+		obj_tetris_rows* row_obj = instance_find<obj_tetris_rows>();
+		if (row_obj != NULL)
 		{
-			obj_tetris_rows* row_obj = static_cast<obj_tetris_rows*>(rows);
-			int width = grid_width(row_obj->filled_blocks);
-			int height = grid_height(row_obj->filled_blocks);
-			print_debug(to_string(width) + " " + to_string(height));
-			for (int i = 0; i < height; i++)
-			{
-				bool filled = true;
-				for (int j = 0; j < width; j++)
-				{
-					if (!grid_get(row_obj->filled_blocks, j, i))
-					{
-						filled = false;
-						break;
-					}
-				}
-
-				if (filled)
-				{
-					highlighted_rows.push_back(i);
-					print_debug(to_string(i));
-				}
-			}
+			highlighted_rows = row_full_mask(row_obj->filled_blocks);
 		}
 
 		phase = 3;
@@ -79,41 +73,30 @@ void subgame_tetris::subgame_step()
 	{
 		// Animate Rows
 		ticker += 1;
-		game_object* rows = get_object_by_name("obj_tetris_rows");
-		if (rows != NULL)
+		obj_tetris_rows* row_obj = instance_find<obj_tetris_rows>();
+		if (row_obj != NULL)
 		{
-			obj_tetris_rows* row_obj = static_cast<obj_tetris_rows*>(rows);
-			for (unsigned int i = 0; i < highlighted_rows.size(); i++)
+			for (int i = 0; i < grid_height(row_obj->filled_blocks); i++)
 			{
-				for (int j = 0; j < grid_width(row_obj->filled_blocks); j++)
-				{
-					grid_set(row_obj->filled_blocks, j, highlighted_rows.at(i), (ticker % 50) > 25);
-				}
+				if ((highlighted_rows >> i) & 1)
+					fill_row(row_obj->filled_blocks, i, (ticker % 50) > 25);
 			}
 		}
 
-		if (ticker > 150 || highlighted_rows.empty())
+		if (ticker > 150 || highlighted_rows == 0)
 			phase = 4;
 	}
 	else if (phase == 4)
 	{
 		// Remove row
-		game_object* rows = get_object_by_name("obj_tetris_rows");
-		if (rows != NULL)
+		obj_tetris_rows* row_obj = instance_find<obj_tetris_rows>();
+		if (row_obj != NULL && highlighted_rows != 0)
 		{
-			obj_tetris_rows* row_obj = static_cast<obj_tetris_rows*>(rows);
-
-			while (!highlighted_rows.empty())
-			{
-				//print_debug(to_string(highlighted_rows.size() - 1));
-				row_obj->shift_down(highlighted_rows.at(highlighted_rows.size() - 1));
-				highlighted_rows.erase(highlighted_rows.begin() + highlighted_rows.size() - 1);
-				game.incrementScore(1);
-				for (unsigned int i = 0; i < highlighted_rows.size(); i++)
-				{
-					highlighted_rows[i] += 1;
-				}
-			}
+			int lines = collapse_rows(row_obj->filled_blocks, highlighted_rows);
+			lines_cleared += lines;
+			game.incrementScore(lines);
+			row_obj->rebuild_skyline();
+			highlighted_rows = 0;
 		}
 
 		phase = 0;
@@ -124,281 +107,88 @@ void subgame_tetris::subgame_step()
 void subgame_tetris::subgame_draw()
 {
 	//printf("Drawing Tetris!!\n");
-	vector<vector<bool>> spr = get_sprite(next_piece, 0);
-	vector<vector<bool>> small_grid = grid_create(4, 4);
-	place_grid_sprite(small_grid, spr, (grid_width(spr) <= 3), (grid_height(spr) <= 3));
-	draw_grid(small_grid, 1280 * .75, 720 / 2, 31);
+	if (preview_taken != pieces.taken || grid_height(preview_grid) != 3 * preview_count + 1)
+		build_preview();
+	draw_grid(preview_grid, 1280 * .75, 720 / 2, 31);
+}
+
+// Upcoming pieces top to bottom, two rows each with a blank row around them
+void subgame_tetris::build_preview()
+{
+	preview_count = std::clamp(preview_count, 1, tetris_preview_max);
+	preview_grid = grid_create(4, 3 * preview_count + 1);
+
+	for (int i = 0; i < preview_count; i++)
+	{
+		int piece = pieces.peek(i);
+		const tetromino_rotation& shape = tetromino_shape(piece, 0);
+		int offset = (tetromino_box_size[piece] <= 3);
+		place_tetromino(preview_grid, shape, offset, 3 * i + 1 - shape.top);
+	}
+
+	preview_taken = pieces.taken;
+}
+
+void subgame_tetris::demo_reset()
+{
+	demo_board = grid_create(grid_width(game.game_grid), grid_height(game.game_grid));
+	demo_pieces.reset(rand(), tetris_randomizer_bag);
+	demo_target = tetris_placement{};
+	demo_tick = game.game_time_in_frames;
+}
+
+// One move of the demo piece: spawn and search, then turn, slide and drop along the
+// same path the search took, then lock
+void subgame_tetris::demo_step()
+{
+	if (!demo_target.valid)
+	{
+		demo_piece = demo_pieces.next();
+		demo_angle = 0;
+		demo_x = grid_width(demo_board) / 2 - 1;
+		demo_y = -2;
+		demo_target = tetris_find_best_placement(demo_board, demo_piece, demo_pieces.peek(0), demo_x, demo_y, ai_weights);
+
+		// Topped out, start over
+		if (!demo_target.valid)
+			grid_clear(demo_board);
+		return;
+	}
+
+	tetris_collision collision{ demo_board, grid_width(demo_board), grid_height(demo_board) };
+	if (demo_angle != demo_target.rotation)
+		collision.rotate(demo_piece, demo_angle, demo_x, demo_y, true);
+	else if (demo_x != demo_target.x)
+		demo_x += (demo_x < demo_target.x) ? 1 : -1;
+	else if (demo_y < demo_target.y)
+		demo_y += 1;
+	else
+	{
+		tetris_apply_placement(demo_board, demo_piece, demo_target);
+		demo_target.valid = false;
+	}
 }
 
 void subgame_tetris::subgame_demo()
 {
-	vector<vector<bool>> sprite;
-	const int frames = 10;
-	int frame = (game.game_time_in_frames / 30) % frames;
+	const unsigned int ticks_per_step = 4;
 
-	switch (frame)
+	if (grid_width(demo_board) != grid_width(game.game_grid) || grid_height(demo_board) != grid_height(game.game_grid))
+		demo_reset();
+
+	// Coming back to the demo after a while picks up where it was
+	if (game.game_time_in_frames - demo_tick > ticks_per_step * 8)
+		demo_tick = game.game_time_in_frames;
+
+	while (game.game_time_in_frames - demo_tick >= ticks_per_step)
 	{
-	case 0:
-		sprite =
-		{
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 1, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 1, 1, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 1, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 1, 1, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 1, 1, 0, 0, 0, 0, 1, 0 },
-			{ 1, 1, 1, 1, 1, 1, 0, 1, 1, 1 },
-			{ 1, 1, 1, 1, 0, 1, 1, 1, 1, 1 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
-		};
-		break;
-	case 1:
-		sprite =
-		{
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 1, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 1, 1, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 1, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 1, 1, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 1, 1, 0, 0, 0, 0, 1, 0 },
-			{ 1, 1, 1, 1, 1, 1, 0, 1, 1, 1 },
-			{ 1, 1, 1, 1, 0, 1, 1, 1, 1, 1 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
-		};
-		break;
-	case 2:
-		sprite =
-		{
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 1, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 1, 1, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 1, 0, 0, 0 },
-			{ 0, 1, 1, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 1, 1, 0, 0, 0, 0, 1, 0 },
-			{ 1, 1, 1, 1, 1, 1, 0, 1, 1, 1 },
-			{ 1, 1, 1, 1, 0, 1, 1, 1, 1, 1 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
-		};
-		break;
-	case 3:
-		sprite =
-		{
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 1, 1, 1, 0, 0 },
-			{ 0, 1, 1, 0, 0, 0, 1, 0, 0, 0 },
-			{ 0, 0, 1, 1, 0, 0, 0, 0, 1, 0 },
-			{ 1, 1, 1, 1, 1, 1, 0, 1, 1, 1 },
-			{ 1, 1, 1, 1, 0, 1, 1, 1, 1, 1 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
-		};
-		break;
-	case 4:
-		sprite =
-		{
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 1, 1, 0, 0, 1, 1, 1, 0, 0 },
-			{ 0, 0, 1, 1, 0, 0, 1, 0, 1, 0 },
-			{ 1, 1, 1, 1, 1, 1, 0, 1, 1, 1 },
-			{ 1, 1, 1, 1, 0, 1, 1, 1, 1, 1 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
-		};
-		break;
-	case 5:
-		sprite =
-		{
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 1, 1, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 1, 1, 0, 1, 1, 1, 1, 0 },
-			{ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
-			{ 1, 1, 1, 1, 0, 1, 1, 1, 1, 1 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
-		};
-		break;
-	case 6:
-		sprite =
-		{
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 1, 1, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 1, 1, 0, 1, 1, 1, 1, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 1, 1, 1, 1, 0, 1, 1, 1, 1, 1 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
-		};
-		break;
-	case 7:
-		sprite =
-		{
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 1, 1, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 1, 1, 0, 1, 1, 1, 1, 0 },
-			{ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
-			{ 1, 1, 1, 1, 0, 1, 1, 1, 1, 1 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-		};
-		break;
-	case 8:
-		sprite =
-		{
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 1, 1, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 1, 1, 0, 1, 1, 1, 1, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 1, 1, 1, 1, 0, 1, 1, 1, 1, 1 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
-		};
-		break;
-	case 9:
-		sprite =
-		{
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 1, 1, 0, 0, 0, 0, 0, 0, 0 },
-			{ 0, 0, 1, 1, 0, 1, 1, 1, 1, 0 },
-			{ 1, 1, 1, 1, 0, 1, 1, 1, 1, 1 },
-			{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
-		};
-		break;
-	default:
-		sprite =
-		{
-			{ 1, 1, 1 },
-			{ 1, 1, 1 },
-			{ 1, 1, 1 }
-		};
+		demo_tick += ticks_per_step;
+		demo_step();
 	}
 
-	place_grid_sprite(game.game_grid, sprite, 0, 1);
-	//print_debug(to_string(frame));
+	emplace_grid_in_grid(game.game_grid, demo_board, 0, 0, true);
+	if (demo_target.valid)
+		place_tetromino(game.game_grid, tetromino_shape(demo_piece, demo_angle), demo_x, demo_y);
 }
 
 // Clean up subgame objects here, runs once when the game is changing to a different
@@ -410,7 +200,7 @@ void subgame_tetris::subgame_exit()
 
 std::string subgame_tetris::subgame_controls_text()
 {
-	return "D-Pad: Move\nA: Clockwise\nY: Counter-C";
+	return "D-Pad: Move\nUp: Drop\nA: Clockwise\nY: Counter-C";
 }
 
 subgame_tetris::obj_tetromino::obj_tetromino(BrickGameFramework& game, int _x, int _y, int _piece_type) : game_object(game, _x, _y)
@@ -420,150 +210,64 @@ subgame_tetris::obj_tetromino::obj_tetromino(BrickGameFramework& game, int _x, i
 	time_til_drop_move = 60;
 	pause_time_drop = 60;
 	shape_index = _piece_type;
+	rows = instance_find<obj_tetris_rows>();
+	lowest_y = _y;
 }
 
-void subgame_tetris::obj_tetromino::change_rotation_by(int amount)
-{
-	angle = (angle + amount + tetris_shapes.at(shape_index).size()) % tetris_shapes.at(shape_index).size();
-}
-
-void subgame_tetris::obj_tetromino::check_spots(vector<vector<int>> _potentials, vector<vector<bool>> _sprite, int _direction)
+void subgame_tetris::obj_tetromino::rotate_piece(bool right)
 {
-	for (unsigned int i = 0; i < _potentials.size(); i++)
+	int _x = x;
+	int _y = y;
+	if (collision().rotate(shape_index, angle, _x, _y, right))
 	{
-		int _x = _potentials.at(i)[0];
-		int _y = -_potentials.at(i)[1];
-
-		if (!check_collision(_sprite, x + _x, y + _y))
-		{
-			change_rotation_by(_direction);
-			x += _x;
-			y += _y;
-			break;
-		}
+		x = _x;
+		y = _y;
+		refresh_lock();
 	}
 }
 
-void subgame_tetris::obj_tetromino::rotate_piece(bool right)
+// Turn, then slide toward the target one move a tick, then hard drop. Anything that
+// doesn't fit just lets the piece fall.
+void subgame_tetris::obj_tetromino::ai_step()
 {
-	int iter = (((double)right) - .5) * 2;
-	vector<vector<bool>> new_shape = get_sprite(shape_index, angle + iter);
+	int last_angle = angle;
+	double last_x = x;
 
-	if (!check_collision(new_shape, x, y))
+	if (angle != target.rotation)
+		rotate_piece(true);
+	else if (x < target.x)
+		move_right();
+	else if (x > target.x)
+		move_left();
+
+	if (angle == target.rotation && x == target.x)
 	{
-		change_rotation_by(iter);
+		hard_drop();
 	}
-	else
+	else if (angle == last_angle && x == last_x)
 	{
-		vector<vector<int>> offset_tests;
-
-		// I piece
-		if (shape_index == 0)
-		{
-			if (angle == 0)
-			{
-				if (iter == 1)
-				{
-					offset_tests = { {0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2} };
-				}
-				else
-				{
-					offset_tests = { {0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1} };
-				}
-			}
-			else if (angle == 1)
-			{
-				if (iter == 1)
-				{
-					offset_tests = { {0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1} };
-				}
-				else
-				{
-					offset_tests = { {0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2} };
-				}
-			}
-			else if (angle == 2)
-			{
-				if (iter == 1)
-				{
-					offset_tests = { {0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2} };
-				}
-				else
-				{
-					offset_tests = { {0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1} };
-				}
-			}
-			else if (angle == 3)
-			{
-				if (iter == 1)
-				{
-					offset_tests = { {0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1} };
-				}
-				else
-				{
-					offset_tests = { {0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2} };
-				}
-			}
-		}
-		// not I piece
-		else
-		{
-			if (angle == 0)
-			{
-				if (iter == 1)
-				{
-					offset_tests = { {0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2} };
-				}
-				else
-				{
-					offset_tests = { {0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2} };
-				}
-			}
-			else if (angle == 1)
-			{
-				if (iter == 1)
-				{
-					offset_tests = { {0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2} };
-				}
-				else
-				{
-					offset_tests = { {0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2} };
-				}
-			}
-			else if (angle == 2)
-			{
-				if (iter == 1)
-				{
-					offset_tests = { {0, 0}, {1, 0}, {1, +1}, {0, -2}, {1, -2} };
-				}
-				else
-				{
-					offset_tests = { {0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2} };
-				}
-			}
-			else if (angle == 3)
-			{
-				if (iter == 1)
-				{
-					offset_tests = { {0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2} };
-				}
-				else
-				{
-					offset_tests = { {0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2} };
-				}
-			}
-		}
-		check_spots(offset_tests, new_shape, iter);
+		move_down();
+		time_til_drop_move = pause_time_drop;
 	}
 }
 
 void subgame_tetris::obj_tetromino::step_function()
 {
-	if (moving)
+	if (moving && ai)
+	{
+		ai_step();
+	}
+	else if (moving)
 	{
 		if (keyboard_check_pressed_left() || keyboard_check_pressed_right() || keyboard_check_pressed_down())
 			time_til_move = 0;
 
+		if (keyboard_check_pressed_up())
+		{
+			hard_drop();
+			return;
+		}
+
 		if (keyboard_check_pressed_Y())
 			rotate_piece(false);
 
@@ -605,12 +309,18 @@ void subgame_tetris::obj_tetromino::step_function()
 			move_down();
 		}
 	}
+
+	if (moving)
+		update_lock();
 }
 
 void subgame_tetris::obj_tetromino::draw_function()
 {
-	vector<vector<bool>> spr = get_sprite(shape_index, angle);
-	place_grid_sprite(game.game_grid, spr, x, y, true);
+	const tetromino_rotation& shape = tetromino_shape(shape_index, angle);
+	place_tetromino(game.game_grid, shape, x, y);
+
+	if (ghost && moving && game.game_time_in_frames % 40 < 20)
+		place_tetromino(game.game_grid, shape, x, y + drop_distance());
 }
 
 void subgame_tetris::obj_tetromino::destroy_function()
@@ -618,118 +328,192 @@ void subgame_tetris::obj_tetromino::destroy_function()
 
 }
 
-int subgame_tetris::obj_tetromino::check_off_top(vector<vector<bool>> shape, int _x, int _y)
+int tetris_collision::test_off_top(const tetromino_rotation& shape, int x, int y) const
+{
+	if (y + shape.top < 0)
+		return 5;
+
+	return 0;
+}
+
+int tetris_collision::test(const tetromino_rotation& shape, int x, int y) const
 {
-	for (int i = 0; i < grid_width(shape); i++)
+	if (x + shape.left < 0)
+		return 1;
+
+	if (x + shape.right >= width)
+		return 2;
+
+	if (y + shape.bottom >= height)
+		return 3;
+
+	const uint64_t* board_rows = board.rows();
+	for (int j = shape.top; j <= shape.bottom; j++)
 	{
-		for (int j = 0; j < grid_height(shape); j++)
-		{
-			if (shape[j][i])
-			{
-				//print_debug("> "+to_string(_x + i) + " " + to_string(_y + j));
-				if (_y + j < 0)
-				{
-					return 5;
-				}
-			}
-		}
+		if (y + j < 0 || y + j >= grid_height(board))
+			continue;
+
+		uint64_t cells = (x >= 0) ? (shape.row(j) << x) : (shape.row(j) >> -x);
+		if (board_rows[y + j] & cells)
+			return 4;
 	}
 
 	return 0;
 }
 
-// 0 - No Collision
-// 1 - Off Board Side Left
-// 2 - Off Board Side Right
-// 3 - Off Board Bottom
-// 4 - Another Piece
-int subgame_tetris::obj_tetromino::check_collision(vector<vector<bool>> shape, int _x, int _y)
+bool tetris_collision::rotate(int piece, int& rotation, int& x, int& y, bool clockwise) const
 {
-	game_object* rows = get_object_by_name("obj_tetris_rows");
+	int turn = clockwise ? 1 : -1;
+	const tetromino_rotation& shape = tetromino_shape(piece, rotation + turn);
+	const kick_offset (&kicks)[kick_tests] = tetromino_kicks(piece, rotation, clockwise);
 
-	for (int i = 0; i < grid_width(shape); i++)
+	// The first kick is no kick at all
+	for (int i = 0; i < kick_tests; i++)
 	{
-		for (int j = 0; j < grid_height(shape); j++)
+		int kick_x = kicks[i].x;
+		int kick_y = -kicks[i].y;
+
+		if (!test(shape, x + kick_x, y + kick_y))
 		{
-			if (shape[j][i])
-			{
-				if (_x + i < 0)
-				{
-					return 1;
-				}
-
-				if (_x + i >= grid_width(game.game_grid))
-				{
-					return 2;
-				}
-
-				if (_y + j >= grid_height(game.game_grid))
-				{
-					return 3;
-				}
-
-				if (rows != NULL)
-				{
-					obj_tetris_rows* row_obj = static_cast<obj_tetris_rows*>(rows);
-					if (grid_get(row_obj->filled_blocks, _x + i, _y + j))
-					{
-						return 4;
-					}
-				}
-			}
+			rotation = (rotation + turn + tetromino_rotations) % tetromino_rotations;
+			x += kick_x;
+			y += kick_y;
+			return true;
 		}
 	}
 
-	return 0;
+	return false;
+}
+
+int tetris_collision::drop_distance(const tetromino_rotation& shape, int x, int y) const
+{
+	int distance = 0;
+	while (!test(shape, x, y + distance + 1))
+		distance += 1;
+
+	return distance;
+}
+
+tetris_collision subgame_tetris::obj_tetromino::collision()
+{
+	static const Grid no_blocks;
+	const Grid& board = (rows != NULL) ? rows->filled_blocks : no_blocks;
+	return tetris_collision{ board, grid_width(game.game_grid), grid_height(game.game_grid) };
+}
+
+int subgame_tetris::obj_tetromino::check_off_top(const tetromino_rotation& shape, int _x, int _y)
+{
+	return collision().test_off_top(shape, _x, _y);
 }
 
-vector<vector<bool>> get_sprite(int _index, int _rotation)
+int subgame_tetris::obj_tetromino::check_collision(const tetromino_rotation& shape, int _x, int _y)
 {
-	return tetris_shapes.at(_index).at((_rotation + tetris_shapes.at(_index).size()) % tetris_shapes.at(_index).size());
+	return collision().test(shape, _x, _y);
+}
+
+// From the skyline when it can tell, otherwise row by row
+int subgame_tetris::obj_tetromino::drop_distance()
+{
+	const tetromino_rotation& shape = tetromino_shape(shape_index, angle);
+	int distance = (rows != NULL) ? rows->drop_distance(shape, x, y) : -1;
+	if (distance < 0)
+		distance = collision().drop_distance(shape, x, y);
+
+	return distance;
+}
+
+// Moving or turning on the ground starts the lock delay over, a limited number of
+// times per row reached
+void subgame_tetris::obj_tetromino::refresh_lock()
+{
+	if (lock_timer > 0 && lock_resets < max_lock_resets)
+	{
+		lock_timer = 0;
+		lock_resets += 1;
+	}
+}
+
+void subgame_tetris::obj_tetromino::update_lock()
+{
+	if (drop_distance() > 0)
+	{
+		lock_timer = 0;
+		return;
+	}
+
+	lock_timer += 1;
+	if (lock_timer >= lock_delay)
+		lock();
+}
+
+void subgame_tetris::obj_tetromino::hard_drop()
+{
+	y += drop_distance();
+	lock();
+}
+
+void subgame_tetris::obj_tetromino::lock()
+{
+	if (rows != NULL)
+	{
+		const tetromino_rotation& shape = tetromino_shape(shape_index, angle);
+		rows->lock_piece(shape, x, y);
+		if (check_off_top(shape, x, y))
+			lose();
+	}
+
+	moving = false;
+	instance_destroy();
+}
+
+// ORs the piece into the grid, anything outside it is dropped
+void place_tetromino(Grid& grid, const tetromino_rotation& shape, int x, int y)
+{
+	for (int j = shape.top; j <= shape.bottom; j++)
+	{
+		if (y + j < 0 || y + j >= grid_height(grid))
+			continue;
+
+		uint64_t cells = (x >= 0) ? (shape.row(j) << x) : (shape.row(j) >> -x);
+		grid.rows()[y + j] |= cells & grid.row_mask();
+	}
 }
 
 void subgame_tetris::obj_tetromino::move_left()
 {
-	if (!check_collision(get_sprite(shape_index, angle), x - 1, y))
+	if (!check_collision(tetromino_shape(shape_index, angle), x - 1, y))
 	{
 		x -= 1;
+		refresh_lock();
 	}
 }
 
 void subgame_tetris::obj_tetromino::move_right()
 {
-	if (!check_collision(get_sprite(shape_index, angle), x + 1, y))
+	if (!check_collision(tetromino_shape(shape_index, angle), x + 1, y))
 	{
 		x += 1;
+		refresh_lock();
 	}
 }
 
 void subgame_tetris::obj_tetromino::lose()
 {
 	game.running = false;
-	objects.push_back(std::make_unique<obj_explosion>(game, 5, 0));
+	instance_create<obj_explosion>(game, 5, 0);
 }
 
+// Landing doesn't lock here, update_lock does once the lock delay runs out
 void subgame_tetris::obj_tetromino::move_down()
 {
-	if (!check_collision(get_sprite(shape_index, angle), x, y + 1))
+	if (!check_collision(tetromino_shape(shape_index, angle), x, y + 1))
 	{
 		y += 1;
-	}
-	else
-	{
-		game_object* rows = get_object_by_name("obj_tetris_rows");
-		if (rows != NULL)
+		if (y > lowest_y)
 		{
-			obj_tetris_rows* row_obj = static_cast<obj_tetris_rows*>(rows);
-
-			vector<vector<bool>> gtp = get_sprite(shape_index, angle);
-			place_grid_sprite(row_obj->filled_blocks, gtp, x, y);
-			//print_debug(to_string(x) + " " + to_string(y));
-			if (check_off_top(gtp, x, y))
-				lose();
+			lowest_y = y;
+			lock_resets = 0;
 		}
-		instance_destroy();
 	}
 }
 
@@ -745,6 +529,7 @@ subgame_tetris::obj_tetris_rows::obj_tetris_rows(BrickGameFramework& game) : gam
 	}
 
 	name = "obj_tetris_rows";
+	rebuild_skyline();
 }
 
 void subgame_tetris::obj_tetris_rows::step_function()
@@ -762,23 +547,78 @@ void subgame_tetris::obj_tetris_rows::destroy_function()
 
 }
 
-void subgame_tetris::obj_tetris_rows::shift_down(int starting_at)
+void subgame_tetris::obj_tetris_rows::rebuild_skyline()
 {
-	for (int yy = starting_at; yy > 0; yy--)
+	const uint64_t* board_rows = filled_blocks.rows();
+	for (int i = 0; i < grid_width(filled_blocks); i++)
+		skyline[i] = grid_height(filled_blocks);
+
+	// Walking up, the last block seen in a column is its highest
+	for (int j = grid_height(filled_blocks) - 1; j >= 0; j--)
 	{
-		for (int xx = 0; xx < grid_width(filled_blocks); xx++)
+		uint64_t cells = board_rows[j];
+		while (cells != 0)
 		{
-			grid_set(filled_blocks, xx, yy, grid_get(filled_blocks, xx, yy - 1));
+			skyline[__builtin_ctzll(cells)] = j;
+			cells &= cells - 1;
 		}
 	}
 }
 
+void subgame_tetris::obj_tetris_rows::lock_piece(const tetromino_rotation& shape, int x, int y)
+{
+	place_tetromino(filled_blocks, shape, x, y);
+
+	// Only the top cell of each column can raise it, the first one found going down
+	uint64_t columns_left = 0;
+	for (int j = shape.top; j <= shape.bottom; j++)
+		columns_left |= shape.row(j);
+
+	for (int j = shape.top; j <= shape.bottom && columns_left != 0; j++)
+	{
+		uint64_t top_cells = shape.row(j) & columns_left;
+		columns_left &= ~top_cells;
+		while (top_cells != 0)
+		{
+			int column = x + __builtin_ctzll(top_cells);
+			top_cells &= top_cells - 1;
+			if (column >= 0 && column < grid_width(filled_blocks) && y + j >= 0)
+				skyline[column] = min(skyline[column], y + j);
+		}
+	}
+}
+
+int subgame_tetris::obj_tetris_rows::drop_distance(const tetromino_rotation& shape, int x, int y)
+{
+	int distance = INT_MAX;
+	for (int i = shape.left; i <= shape.right; i++)
+	{
+		int column = x + i;
+		if (column < 0 || column >= grid_width(filled_blocks))
+			return -1;
+
+		int bottom = y + shape.column_bottom[i];
+		if (bottom >= skyline[column])
+			return -1;
+
+		distance = min(distance, skyline[column] - 1 - bottom);
+	}
+
+	return distance;
+}
+
+void subgame_tetris::obj_tetris_rows::shift_down(int starting_at)
+{
+	shift_down_from(filled_blocks, starting_at);
+	rebuild_skyline();
+}
+
 void subgame_tetris::obj_tetris_rows::check_rows()
 {
 
 }
 
-int subgame_tetris::obj_tetris_rows::lowest_occupied_line(std::vector<std::vector<bool>>& grid)
+int subgame_tetris::obj_tetris_rows::lowest_occupied_line(Grid& grid)
 {
-	return 0;
+	return max(0, lowest_occupied_row(grid));
 }
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <games/game_tetris.h>
+#include <games/game_tetris_ai.h>
+#include <grid_rows.hpp>
+
+int tetris_enumerate_placements(const Grid& board, int piece, int x, int y, tetris_placement (&placements)[tetris_max_placements])
+{
+	tetris_collision collision{ board, grid_width(board), grid_height(board) };
+	int count = 0;
+
+	int rotation = 0;
+	if (collision.test(tetromino_shape(piece, rotation), x, y))
+		return 0;
+
+	for (int turns = 0; turns < tetromino_rotations; turns++)
+	{
+		if (turns > 0 && !collision.rotate(piece, rotation, x, y, true))
+			break;
+
+		// O turns into itself
+		const tetromino_rotation& shape = tetromino_shape(piece, rotation);
+		bool repeat = false;
+		for (int i = 0; i < turns; i++)
+			repeat |= (tetromino_shape(piece, i).mask == shape.mask);
+		if (repeat)
+			continue;
+
+		int left = x;
+		while (!collision.test(shape, left - 1, y))
+			left -= 1;
+		int right = x;
+		while (!collision.test(shape, right + 1, y))
+			right += 1;
+
+		for (int column = left; column <= right; column++)
+		{
+			int drop = y + collision.drop_distance(shape, column, y);
+
+			tetris_placement& placement = placements[count++];
+			placement = tetris_placement{};
+			placement.rotation = rotation;
+			placement.x = column;
+			placement.y = drop;
+			placement.valid = !collision.test_off_top(shape, column, drop);
+		}
+	}
+
+	return count;
+}
+
+int tetris_apply_placement(Grid& board, int piece, const tetris_placement& placement)
+{
+	place_tetromino(board, tetromino_shape(piece, placement.rotation), placement.x, placement.y);
+	return collapse_rows(board, row_full_mask(board));
+}
+
+float tetris_evaluate(const Grid& board, int lines, const tetris_ai_weights& weights)
+{
+	const uint64_t* rows = board.rows();
+	int height = grid_height(board);
+
+	// Walking down, a column's height is set by the first filled cell seen in it and
+	// every empty cell under one is a hole
+	int column_heights[Grid::max_width] = {};
+	uint64_t covered = 0;
+	int holes = 0;
+	for (int j = 0; j < height; j++)
+	{
+		holes += __builtin_popcountll(covered & ~rows[j]);
+
+		uint64_t first = rows[j] & ~covered;
+		while (first != 0)
+		{
+			column_heights[__builtin_ctzll(first)] = height - j;
+			first &= first - 1;
+		}
+		covered |= rows[j];
+	}
+
+	int aggregate_height = 0;
+	int bumpiness = 0;
+	for (int i = 0; i < grid_width(board); i++)
+	{
+		aggregate_height += column_heights[i];
+		if (i > 0)
+			bumpiness += abs(column_heights[i] - column_heights[i - 1]);
+	}
+
+	return weights.aggregate_height * aggregate_height + weights.lines * lines
+		+ weights.holes * holes + weights.bumpiness * bumpiness;
+}
+
+// Score of one first move: the board it leaves, or the best the next piece can do after it
+static float score_first_move(const Grid& board, int piece, const tetris_placement& placement, int next_piece, int x, int y,
+	const tetris_ai_weights& weights)
+{
+	if (!placement.valid)
+		return tetris_losing_score;
+
+	Grid after = board;
+	int lines = tetris_apply_placement(after, piece, placement);
+	if (next_piece < 0)
+		return tetris_evaluate(after, lines, weights);
+
+	tetris_placement next_placements[tetris_max_placements];
+	int next_count = tetris_enumerate_placements(after, next_piece, x, y, next_placements);
+
+	float best = tetris_losing_score;
+	for (int i = 0; i < next_count; i++)
+	{
+		if (!next_placements[i].valid)
+			continue;
+
+		Grid after_next = after;
+		int next_lines = tetris_apply_placement(after_next, next_piece, next_placements[i]);
+		best = std::max(best, tetris_evaluate(after_next, lines + next_lines, weights));
+	}
+
+	return best;
+}
+
+tetris_placement tetris_find_best_placement(const Grid& board, int piece, int next_piece, int x, int y,
+	const tetris_ai_weights& weights, int threads)
+{
+	tetris_placement placements[tetris_max_placements];
+	int count = tetris_enumerate_placements(board, piece, x, y, placements);
+
+	auto score_range = [&](int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+			placements[i].score = score_first_move(board, piece, placements[i], next_piece, x, y, weights);
+	};
+
+	threads = std::clamp(threads, 1, std::max(count, 1));
+	if (threads == 1)
+	{
+		score_range(0, count);
+	}
+	else
+	{
+		// Each first move only reads the board, so they split cleanly by index
+		std::thread workers[tetris_max_placements];
+		for (int t = 0; t < threads; t++)
+			workers[t] = std::thread(score_range, count * t / threads, count * (t + 1) / threads);
+		for (int t = 0; t < threads; t++)
+			workers[t].join();
+	}
+
+	// Earliest wins ties, so the pick doesn't depend on the thread count
+	tetris_placement best;
+	best.score = tetris_losing_score;
+	for (int i = 0; i < count; i++)
+	{
+		if (!best.valid || placements[i].score > best.score)
+			best = placements[i];
+	}
+
+	return best;
+}
@@ -0,0 +1,83 @@
+#include <games/game_tetris_pieces.h>
+
+void tetris_random::seed(uint64_t seed)
+{
+	// splitmix64 spreads small seeds out, and xorshift can't start from 0
+	seed += 0x9E3779B97F4A7C15ULL;
+	seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+	state = seed ^ (seed >> 31);
+	if (state == 0)
+		state = 1;
+}
+
+uint32_t tetris_random::next()
+{
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+	return (uint32_t)((state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+int tetris_random::below(int count)
+{
+	return (int)(((uint64_t)next() * (uint64_t)count) >> 32);
+}
+
+void tetris_piece_queue::reset(uint64_t seed, tetris_randomizer _mode)
+{
+	random.seed(seed);
+	mode = _mode;
+	bag_left = 0;
+	last_dealt = -1;
+	taken = 0;
+
+	first = 0;
+	for (int i = 0; i < tetris_preview_max; i++)
+		upcoming[i] = deal();
+}
+
+int tetris_piece_queue::next()
+{
+	int piece = upcoming[first];
+	upcoming[first] = deal();
+	first = (first + 1) % tetris_preview_max;
+	taken += 1;
+	return piece;
+}
+
+int tetris_piece_queue::peek(int index) const
+{
+	return upcoming[(first + index) % tetris_preview_max];
+}
+
+int tetris_piece_queue::deal()
+{
+	int piece;
+
+	if (mode == tetris_randomizer_classic)
+	{
+		// Eight sides, the eighth and a repeat both roll again from seven
+		piece = random.below(tetromino_count + 1);
+		if (piece == tetromino_count || piece == last_dealt)
+			piece = random.below(tetromino_count);
+	}
+	else
+	{
+		if (bag_left == 0)
+		{
+			for (int i = 0; i < tetromino_count; i++)
+				bag[i] = i;
+			bag_left = tetromino_count;
+		}
+
+		// Draw from what's left of the bag, the last one fills the gap
+		int pick = random.below(bag_left);
+		piece = bag[pick];
+		bag_left -= 1;
+		bag[pick] = bag[bag_left];
+	}
+
+	last_dealt = piece;
+	return piece;
+}
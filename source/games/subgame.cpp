@@ -2,6 +2,7 @@
 #include <game.h>
 #include <games/subgame.h>
 #include <grid_sprites.h>
+#include <utils/log.h>
 
 subgame::subgame(BrickGameFramework& game_) :game(game_)
 {
@@ -10,27 +11,27 @@ subgame::subgame(BrickGameFramework& game_) :game(game_)
 
 void subgame::subgame_init()
 {
-	printf("Subgame Init\n");
+	LOG_TRACE(log_games, "Subgame Init");
 }
 
 void subgame::subgame_step()
 {
-	printf("Subgame Run\n");
+	LOG_TRACE(log_games, "Subgame Run");
 }
 
 void subgame::subgame_draw()
 {
-	printf("Subgame Draw\n");
+	LOG_TRACE(log_games, "Subgame Draw");
 }
 
 void subgame::subgame_exit()
 {
-	printf("Subgame Exit\n");
+	LOG_TRACE(log_games, "Subgame Exit");
 }
 
 void subgame::subgame_demo()
 {
-	vector<vector<bool>> sprite;
+	Grid sprite;
 
 	if (game.game_time_in_frames % 120 < 60)
 	{
@@ -1,99 +1,117 @@
 #include <vector>
 #include <cstdio>
+#include <cstring>
+#include <algorithm>
 #include <grid.hpp>
 
-std::vector<std::vector<bool>> grid_create(int width, int height)
+Grid::Grid() : Grid(0, 0)
 {
-	//printf("Grid create: %i, %i\n", width, height);
+}
+
+Grid::Grid(int _width, int _height)
+{
+	width = std::clamp(_width, 0, max_width);
+	height = std::clamp(_height, 0, max_height);
+
+	inline_data.fill(0);
+	if (height > inline_rows)
+		heap_data.assign(height, 0);
+}
+
+Grid::Grid(std::initializer_list<std::initializer_list<bool>> _rows)
+{
+	int longest_row = 0;
+	for (auto& row : _rows)
+		longest_row = std::max(longest_row, (int)row.size());
 
-	std::vector<std::vector<bool>> grid;
+	*this = Grid(longest_row, (int)_rows.size());
 
-	for (int i = 0; i < width; i++)
+	int j = 0;
+	for (auto& row : _rows)
 	{
-		std::vector<bool> sub;
-		for (int j = 0; j < height; j++)
+		int i = 0;
+		for (bool cell : row)
 		{
-			sub.push_back(false);
+			grid_set(*this, i, j, cell);
+			i++;
 		}
-		grid.push_back(sub);
+		j++;
 	}
+}
 
-	return grid;
+Grid grid_create(int width, int height)
+{
+	//printf("Grid create: %i, %i\n", width, height);
+
+	return Grid(width, height);
 }
 
-bool grid_get(std::vector<std::vector<bool>>& grid, int x, int y)
+bool grid_get(const Grid& grid, int x, int y)
 {
-	if (x >= 0 && x < (int)grid.size())
-	{
-		std::vector<bool> sub = grid.at(x);
-		if (y >= 0 && y < (int)sub.size())
-		{
-			return sub.at(y);
-		}
-	}
+	if (point_in_grid(grid, x, y))
+		return grid_get_unchecked(grid, x, y);
 
 	return false;
 }
 
-bool grid_set(std::vector<std::vector<bool>>& grid, int x, int y, bool val, bool additive)
+bool grid_set(Grid& grid, int x, int y, bool val, bool additive)
 {
 	if (!additive || (additive && val))
-		if (x >= 0 && x < (int)grid.size())
+		if (point_in_grid(grid, x, y))
 		{
-			std::vector<bool>& sub = grid.at(x);
-			if (y >= 0 && y < (int)sub.size())
-			{
-				sub.at(y) = val;
-				return true;
-			}
+			uint64_t bit = (uint64_t)1 << x;
+			if (val)
+				grid.rows()[y] |= bit;
+			else
+				grid.rows()[y] &= ~bit;
+			return true;
 		}
 
 	return false;
 }
 
-int grid_width(std::vector<std::vector<bool>>& grid)
+int grid_width(const Grid& grid)
 {
-	return grid.size();
+	return grid.width;
 }
 
-int grid_height(std::vector<std::vector<bool>>& grid)
+int grid_height(const Grid& grid)
 {
-	return grid.at(0).size();
+	return grid.height;
 }
 
-void grid_clear(std::vector<std::vector<bool>>& grid)
+void grid_clear(Grid& grid)
 {
-	for (int i = 0; i < grid_width(grid); i++)
-	{
-		for (int j = 0; j < grid_height(grid); j++)
-		{
-			grid_set(grid, i, j, false);
-		}
-	}
+	memset(grid.rows(), 0, sizeof(uint64_t) * grid.height);
 }
 
-bool point_in_grid(std::vector<std::vector<bool>>& grid, int x, int y)
+bool point_in_grid(const Grid& grid, int x, int y)
 {
 	return (x >= 0 && y >= 0 && x < grid_width(grid) && y < grid_height(grid));
 }
 
-void emplace_grid_in_grid(vector<vector<bool>>& base_grid, vector<vector<bool>>& grid_to_place, int x, int y, bool additive)
+void emplace_grid_in_grid(Grid& base_grid, const Grid& grid_to_place, int x, int y, bool additive)
 {
-	vector<vector<bool>> sprite = grid_to_place;
-	int sprite_width = grid_width(sprite);
-	int sprite_height = grid_height(sprite);
+	// Entirely off to one side, nothing can land
+	if (x >= grid_width(base_grid) || x <= -grid_width(grid_to_place))
+		return;
 
-	for (int i = 0; i < sprite_width; i++)
+	uint64_t* base_rows = base_grid.rows();
+	const uint64_t* sprite_rows = grid_to_place.rows();
+	uint64_t base_mask = base_grid.row_mask();
+	uint64_t sprite_mask = grid_to_place.row_mask();
+	uint64_t covered = ((x >= 0) ? (sprite_mask << x) : (sprite_mask >> -x)) & base_mask;
+
+	int first_row = std::max(0, -y);
+	int last_row = std::min(grid_height(grid_to_place), grid_height(base_grid) - y);
+
+	for (int j = first_row; j < last_row; j++)
 	{
-		for (int j = 0; j < sprite_height; j++)
-		{
-			if (additive)
-			{
-				if (grid_get(sprite, i, j))
-					grid_set(base_grid, x + i, y + j, true);
-			}
-			else
-				grid_set(base_grid, x + i, y + j, grid_get(sprite, i, j));
-		}
+		uint64_t shifted = ((x >= 0) ? (sprite_rows[j] << x) : (sprite_rows[j] >> -x)) & base_mask;
+
+		if (additive)
+			base_rows[y + j] |= shifted;
+		else
+			base_rows[y + j] = (base_rows[y + j] & ~covered) | shifted;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,80 @@
+#include <cstring>
+#include <grid.hpp>
+#include <grid_rows.hpp>
+
+uint64_t row_full_mask(const Grid& grid)
+{
+	const uint64_t* rows = grid.rows();
+	uint64_t full = grid.row_mask();
+	uint64_t mask = 0;
+
+	for (int y = 0; y < grid_height(grid); y++)
+	{
+		if (rows[y] == full)
+			mask |= (uint64_t)1 << y;
+	}
+
+	return mask;
+}
+
+int collapse_rows(Grid& grid, uint64_t mask, bool toward_top)
+{
+	uint64_t* rows = grid.rows();
+	int height = grid_height(grid);
+	int removed = 0;
+
+	if (toward_top)
+	{
+		int write = 0;
+		for (int y = 0; y < height; y++)
+		{
+			if ((mask >> y) & 1)
+				removed += 1;
+			else
+				rows[write++] = rows[y];
+		}
+		memset(rows + write, 0, sizeof(uint64_t) * (height - write));
+	}
+	else
+	{
+		int write = height - 1;
+		for (int y = height - 1; y >= 0; y--)
+		{
+			if ((mask >> y) & 1)
+				removed += 1;
+			else
+				rows[write--] = rows[y];
+		}
+		memset(rows, 0, sizeof(uint64_t) * (write + 1));
+	}
+
+	return removed;
+}
+
+void shift_down_from(Grid& grid, int row)
+{
+	if (row < 0 || row >= grid_height(grid))
+		return;
+
+	uint64_t* rows = grid.rows();
+	memmove(rows + 1, rows, sizeof(uint64_t) * row);
+	rows[0] = 0;
+}
+
+void fill_row(Grid& grid, int row, bool val)
+{
+	if (row >= 0 && row < grid_height(grid))
+		grid.rows()[row] = val ? grid.row_mask() : 0;
+}
+
+int lowest_occupied_row(const Grid& grid)
+{
+	const uint64_t* rows = grid.rows();
+	for (int y = grid_height(grid) - 1; y >= 0; y--)
+	{
+		if (rows[y] != 0)
+			return y;
+	}
+
+	return -1;
+}
\ No newline at end of file
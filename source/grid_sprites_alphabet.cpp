@@ -2,7 +2,7 @@
 #include <grid_sprites_alphabet.h>
 using namespace std;
 
-vector<vector<bool>> grid_sprite_alphabet_space
+Grid grid_sprite_alphabet_space
 {
 	{ 0, 0, 0, 0, 0 },
 	{ 0, 0, 0, 0, 0 },
@@ -11,7 +11,7 @@ vector<vector<bool>> grid_sprite_alphabet_space
 	{ 0, 0, 0, 0, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_c
+Grid grid_sprite_alphabet_c
 {
 	{ 0, 1, 1, 1, 0 },
 	{ 1, 0, 0, 0, 0 },
@@ -20,7 +20,7 @@ vector<vector<bool>> grid_sprite_alphabet_c
 	{ 0, 1, 1, 1, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_e
+Grid grid_sprite_alphabet_e
 {
 	{ 1, 1, 1, 1, 0 },
 	{ 1, 0, 0, 0, 0 },
@@ -29,7 +29,7 @@ vector<vector<bool>> grid_sprite_alphabet_e
 	{ 1, 1, 1, 1, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_l
+Grid grid_sprite_alphabet_l
 {
 	{ 1, 0, 0, 0, 0 },
 	{ 1, 0, 0, 0, 0 },
@@ -38,7 +38,7 @@ vector<vector<bool>> grid_sprite_alphabet_l
 	{ 1, 1, 1, 1, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_m
+Grid grid_sprite_alphabet_m
 {
 	{ 0, 1, 0, 1, 0 },
 	{ 1, 0, 1, 0, 1 },
@@ -47,7 +47,7 @@ vector<vector<bool>> grid_sprite_alphabet_m
 	{ 1, 0, 0, 0, 1 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_o
+Grid grid_sprite_alphabet_o
 {
 	{ 0, 1, 1, 0, 0 },
 	{ 1, 0, 0, 1, 0 },
@@ -56,7 +56,7 @@ vector<vector<bool>> grid_sprite_alphabet_o
 	{ 0, 1, 1, 0, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_w
+Grid grid_sprite_alphabet_w
 {
 	{ 1, 0, 0, 0, 1 },
 	{ 1, 0, 0, 0, 1 },
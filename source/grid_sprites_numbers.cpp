@@ -2,7 +2,7 @@
 #include <grid_sprites_numbers.h>
 using namespace std;
 
-vector<vector<bool>> grid_sprite_alphabet_0
+Grid grid_sprite_alphabet_0
 {
 	{ 0, 1, 1, 0, 0 },
 	{ 1, 0, 0, 1, 0 },
@@ -11,7 +11,7 @@ vector<vector<bool>> grid_sprite_alphabet_0
 	{ 0, 1, 1, 0, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_1
+Grid grid_sprite_alphabet_1
 {
 	{ 0, 1, 0, 0, 0 },
 	{ 1, 1, 0, 0, 0 },
@@ -20,7 +20,7 @@ vector<vector<bool>> grid_sprite_alphabet_1
 	{ 1, 1, 1, 0, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_2
+Grid grid_sprite_alphabet_2
 {
 	{ 0, 1, 1, 0, 0 },
 	{ 1, 0, 0, 1, 0 },
@@ -29,7 +29,7 @@ vector<vector<bool>> grid_sprite_alphabet_2
 	{ 1, 1, 1, 1, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_3
+Grid grid_sprite_alphabet_3
 {
 	{ 0, 1, 1, 0, 0 },
 	{ 1, 0, 0, 1, 0 },
@@ -38,7 +38,7 @@ vector<vector<bool>> grid_sprite_alphabet_3
 	{ 0, 1, 1, 0, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_4
+Grid grid_sprite_alphabet_4
 {
 	{ 1, 0, 1, 0, 0 },
 	{ 1, 0, 1, 0, 0 },
@@ -47,7 +47,7 @@ vector<vector<bool>> grid_sprite_alphabet_4
 	{ 0, 0, 1, 0, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_5
+Grid grid_sprite_alphabet_5
 {
 	{ 1, 1, 1, 0, 0 },
 	{ 1, 0, 0, 0, 0 },
@@ -56,7 +56,7 @@ vector<vector<bool>> grid_sprite_alphabet_5
 	{ 1, 1, 0, 0, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_6
+Grid grid_sprite_alphabet_6
 {
 	{ 1, 1, 1, 0, 0 },
 	{ 1, 0, 0, 0, 0 },
@@ -65,7 +65,7 @@ vector<vector<bool>> grid_sprite_alphabet_6
 	{ 1, 1, 1, 0, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_7
+Grid grid_sprite_alphabet_7
 {
 	{ 1, 1, 1, 0, 0 },
 	{ 0, 0, 1, 0, 0 },
@@ -74,7 +74,7 @@ vector<vector<bool>> grid_sprite_alphabet_7
 	{ 0, 1, 0, 0, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_8
+Grid grid_sprite_alphabet_8
 {
 	{ 1, 1, 1, 0, 0 },
 	{ 1, 0, 1, 0, 0 },
@@ -83,7 +83,7 @@ vector<vector<bool>> grid_sprite_alphabet_8
 	{ 1, 1, 1, 0, 0 }
 };
 
-vector<vector<bool>> grid_sprite_alphabet_9
+Grid grid_sprite_alphabet_9
 {
 	{ 1, 1, 1, 0, 0 },
 	{ 1, 0, 1, 0, 0 },
@@ -92,7 +92,7 @@ vector<vector<bool>> grid_sprite_alphabet_9
 	{ 1, 1, 0, 0, 0 }
 };
 
-vector<vector<bool>> get_gridsprite_number(int i)
+const Grid& get_gridsprite_number(int i)
 {
 	switch (i)
 	{
@@ -0,0 +1,53 @@
+#include <cstdlib>
+#include <ctime>
+#include <game.h>
+#include <utils/settings.h>
+#include <utils/scores.h>
+#include <utils/log.h>
+#include <platform/audio_layer.h>
+
+#ifdef __SWITCH__
+#include <switch.h>
+#include <switch/runtime/devices/socket.h>
+
+static int nxlink_sock = -1;
+
+extern "C" void userAppInit(void)
+{
+	romfsInit();
+	socketInitialize(NULL);
+	nxlink_sock = nxlinkConnectToHost(true, true);
+}
+
+extern "C" void userAppExit(void)
+{
+	if (nxlink_sock != -1)
+		close(nxlink_sock);
+	socketExit();
+	romfsExit();
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+	start_log_writer();
+
+	read_settings();
+	init_settings();
+
+	init_audio();
+
+	read_scores();
+	start_score_writer();
+
+	srand(time(NULL));
+
+	BrickGameFramework app;
+	app.run();
+
+	stop_score_writer();
+	settings_flush();
+	exit_audio();
+	stop_log_writer();
+	return 0;
+}
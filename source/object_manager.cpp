@@ -1,61 +1,75 @@
 #include <stdio.h>
+#include <algorithm>
 #include <vector>
 #include <grid.hpp>
 #include <functional>
 #include <memory>
 #include <object_manager.h>
 #include <game.h>
+#include <utils/log.h>
 using namespace std;
 
+// Queued by instance_create and instance_destroy, drained by apply_object_updates.
+// They keep their capacity, so steady-state frames don't allocate here either.
+static vector<game_object*> pending_creates;
+static vector<game_object*> pending_destroys;
+static bool deferring_updates = false;
+
+static void queue_destroy(game_object* instance)
+{
+	pending_destroys.push_back(instance);
+}
+
 game_object::game_object(BrickGameFramework& _game, int _x, int _y) : game(_game), x(_x), y(_y)
 {
 	id = object_index;
 	object_index += 1;
-	printf("ID: %u\n", id);
-	printf("Obj create\n");
+	LOG_TRACE(log_objects, "Obj create %u", id);
 	direction = direction_right;
 	name = "object";
 }
 
 void game_object::step_function()
 {
-	printf("ID: %u\n", id);
-	printf("Obj step\n");
+	LOG_TRACE(log_objects, "Obj step %u", id);
 };
 
 void game_object::draw_function()
 {
-	printf("ID: %u\n", id);
-	printf("Obj draw\n");
+	LOG_TRACE(log_objects, "Obj draw %u", id);
 };
 
 void game_object::destroy_function()
 {
-	printf("ID: %u\n", id);
-	printf("Obj destroy\n");
+	LOG_TRACE(log_objects, "Obj destroy %u", id);
 };
 
 void game_object::instance_destroy()
 {
+	if (marked_for_destruction)
+		return;
+
 	marked_for_destruction = true;
+	queue_destroy(this);
 }
 
 obj_explosion::obj_explosion(BrickGameFramework& game, int _x, int _y) : game_object(game, _x, _y)
 {
 	animation_percent = 0;
+	steps_when_stopped = true;
 }
 
+// Advances per tick, so it keeps pace with fast-forward and time_scale
 void obj_explosion::step_function()
 {
-
+	if (animation_percent <= 100)
+		animation_percent += 2;
 }
 
 void obj_explosion::draw_function()
 {
-	if (animation_percent < 100)
+	if (animation_percent > 0 && animation_percent <= 100)
 	{
-		animation_percent += 2;
-
 		for (int i = 0; i < 360; i += 5)
 		{
 			double radius = 4.5;
@@ -80,26 +94,92 @@ void obj_explosion::destroy_function()
 
 }
 
-// Get first object of name
-game_object* get_object_by_name(std::string name)
+static vector<void (*)(game_object*)> object_releasers;
+
+int register_object_type(void (*release)(game_object*))
+{
+	object_releasers.push_back(release);
+	objects_by_type.resize(object_releasers.size());
+	return object_releasers.size() - 1;
+}
+
+static void add_instance(game_object* instance)
+{
+	instance->object_slot = objects.size();
+	objects.push_back(instance);
+
+	vector<game_object*>& instances = objects_by_type[instance->type_id];
+	instance->type_slot = instances.size();
+	instances.push_back(instance);
+}
+
+void register_instance(game_object* instance, int type_id)
+{
+	instance->type_id = type_id;
+
+	if (deferring_updates)
+		pending_creates.push_back(instance);
+	else
+		add_instance(instance);
+}
+
+// Swap-and-pop out of both lists, then back to the pool
+static void free_instance(game_object* instance)
 {
-	for (unsigned int j = 0; j < objects.size(); j++)
+	game_object* last = objects.back();
+	objects[instance->object_slot] = last;
+	last->object_slot = instance->object_slot;
+	objects.pop_back();
+
+	vector<game_object*>& instances = objects_by_type[instance->type_id];
+	last = instances.back();
+	instances[instance->type_slot] = last;
+	last->type_slot = instance->type_slot;
+	instances.pop_back();
+
+	object_releasers[instance->type_id](instance);
+}
+
+void begin_object_updates()
+{
+	deferring_updates = true;
+}
+
+void apply_object_updates()
+{
+	// destroy_function can create or destroy more, those get queued and picked up
+	// by the next time around
+	deferring_updates = true;
+
+	while (!pending_creates.empty() || !pending_destroys.empty())
 	{
-		if (objects.at(j)->name == name)
+		for (game_object* instance : pending_creates)
+			add_instance(instance);
+		pending_creates.clear();
+
+		for (unsigned int i = 0; i < pending_destroys.size(); i++)
 		{
-			return objects.at(j).get();
+			pending_destroys[i]->destroy_function();
+			free_instance(pending_destroys[i]);
 		}
+		pending_destroys.clear();
 	}
 
-	print_debug("Could not find " + name);
-	return NULL;
+	deferring_updates = false;
 }
 
-bool object_exists(std::string name)
+void instance_destroy_all()
 {
-	return (get_object_by_name(name) != NULL);
+	for (game_object* instance : pending_creates)
+		add_instance(instance);
+	pending_creates.clear();
+	pending_destroys.clear();
+
+	while (!objects.empty())
+		free_instance(objects.back());
 }
 
 unsigned int game_object::object_index = 0;
 
-vector<std::unique_ptr<game_object>> objects;
+vector<game_object*> objects;
+vector<vector<game_object*>> objects_by_type;
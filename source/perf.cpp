@@ -12,6 +12,7 @@ void initGraph(PerfGraph* fps, int style, const char* name)
 	fps->style = style;
 	strncpy(fps->name, name, sizeof(fps->name));
 	fps->name[sizeof(fps->name) - 1] = '\0';
+	fps->font = -1;
 }
 
 void updateGraph(PerfGraph* fps, float frameTime)
@@ -82,7 +83,10 @@ void renderGraph(NVGcontext* vg, float x, float y, PerfGraph* fps)
 	nvgFillColor(vg, nvgRGBA(255, 192, 0, 128));
 	nvgFill(vg);
 
-	nvgFontFace(vg, "sans");
+	if (fps->font != -1)
+		nvgFontFaceId(vg, fps->font);
+	else
+		nvgFontFace(vg, "sans");
 
 	if (fps->name[0] != '\0') {
 		nvgFontSize(vg, 12.0f);
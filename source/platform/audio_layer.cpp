@@ -0,0 +1,43 @@
+#include <platform/audio_layer.h>
+#include <settings.h>
+
+#ifdef __SWITCH__
+#include <platform/switch/audio_layer_switch.h>
+#define PLATFORM(function) function##_switch
+#else
+#include <platform/pc/audio_layer_pc.h>
+#define PLATFORM(function) function##_pc
+#endif
+
+bool init_audio()
+{
+	bool result = PLATFORM(init_audio)();
+
+	if (!settings.music)
+		set_music_enabled(false);
+
+	if (!settings.sound)
+		set_sounds_enabled(false);
+
+	return result;
+}
+
+bool exit_audio()
+{
+	return PLATFORM(exit_audio)();
+}
+
+void play_sound(const char* sound_name)
+{
+	PLATFORM(play_sound)(sound_name);
+}
+
+void set_music_enabled(bool enabled)
+{
+	PLATFORM(set_music_enabled)(enabled);
+}
+
+void set_sounds_enabled(bool enabled)
+{
+	PLATFORM(set_sounds_enabled)(enabled);
+}
@@ -1,36 +1,43 @@
 #include <platform/control_layer.h>
-#include <platform/switch/control_layer_switch.h>
-
-void init_controllers() { init_controllers_switch(); }
-void update_controller() { update_controllers_switch(); }
-
-bool keyboard_check_up() { return keyboard_check_up_switch(); }
-bool keyboard_check_right() { return keyboard_check_right_switch(); }
-bool keyboard_check_left() { return keyboard_check_left_switch(); }
-bool keyboard_check_down() { return keyboard_check_down_switch(); }
-
-bool keyboard_check_L() { return keyboard_check_L_switch(); }
-bool keyboard_check_R() { return keyboard_check_R_switch(); }
-bool keyboard_check_ZL() { return keyboard_check_ZL_switch(); }
-bool keyboard_check_ZR() { return keyboard_check_ZR_switch(); }
-
-bool keyboard_check_A() { return keyboard_check_A_switch(); }
-bool keyboard_check_B() { return keyboard_check_B_switch(); }
-bool keyboard_check_X() { return keyboard_check_X_switch(); }
-bool keyboard_check_Y() { return keyboard_check_Y_switch(); }
 
-bool keyboard_check_pressed_right() { return keyboard_check_pressed_right_switch(); }
-bool keyboard_check_pressed_up() { return keyboard_check_pressed_up_switch(); }
-bool keyboard_check_pressed_left() { return keyboard_check_pressed_left_switch(); }
-bool keyboard_check_pressed_down() { return keyboard_check_pressed_down_switch(); }
-
-bool keyboard_check_pressed_A() { return keyboard_check_pressed_A_switch(); }
-bool keyboard_check_pressed_B() { return keyboard_check_pressed_B_switch(); }
-bool keyboard_check_pressed_X() { return keyboard_check_pressed_X_switch(); }
-bool keyboard_check_pressed_Y() { return keyboard_check_pressed_Y_switch(); }
-
-bool keyboard_check_pressed_L() { return keyboard_check_pressed_L_switch(); }
-bool keyboard_check_pressed_R() { return keyboard_check_pressed_R_switch(); }
-
-bool keyboard_check_pressed_start() { return keyboard_check_pressed_start_switch(); }
-bool keyboard_check_pressed_select() { return keyboard_check_pressed_select_switch(); }
\ No newline at end of file
+#ifdef __SWITCH__
+#include <platform/switch/control_layer_switch.h>
+#define PLATFORM(function) function##_switch
+#else
+#include <platform/pc/control_layer_pc.h>
+#define PLATFORM(function) function##_pc
+#endif
+
+void init_controllers() { PLATFORM(init_controllers)(); }
+void update_controller() { PLATFORM(update_controllers)(); }
+
+bool keyboard_check_up() { return PLATFORM(keyboard_check_up)(); }
+bool keyboard_check_right() { return PLATFORM(keyboard_check_right)(); }
+bool keyboard_check_left() { return PLATFORM(keyboard_check_left)(); }
+bool keyboard_check_down() { return PLATFORM(keyboard_check_down)(); }
+
+bool keyboard_check_L() { return PLATFORM(keyboard_check_L)(); }
+bool keyboard_check_R() { return PLATFORM(keyboard_check_R)(); }
+bool keyboard_check_ZL() { return PLATFORM(keyboard_check_ZL)(); }
+bool keyboard_check_ZR() { return PLATFORM(keyboard_check_ZR)(); }
+
+bool keyboard_check_A() { return PLATFORM(keyboard_check_A)(); }
+bool keyboard_check_B() { return PLATFORM(keyboard_check_B)(); }
+bool keyboard_check_X() { return PLATFORM(keyboard_check_X)(); }
+bool keyboard_check_Y() { return PLATFORM(keyboard_check_Y)(); }
+
+bool keyboard_check_pressed_right() { return PLATFORM(keyboard_check_pressed_right)(); }
+bool keyboard_check_pressed_up() { return PLATFORM(keyboard_check_pressed_up)(); }
+bool keyboard_check_pressed_left() { return PLATFORM(keyboard_check_pressed_left)(); }
+bool keyboard_check_pressed_down() { return PLATFORM(keyboard_check_pressed_down)(); }
+
+bool keyboard_check_pressed_A() { return PLATFORM(keyboard_check_pressed_A)(); }
+bool keyboard_check_pressed_B() { return PLATFORM(keyboard_check_pressed_B)(); }
+bool keyboard_check_pressed_X() { return PLATFORM(keyboard_check_pressed_X)(); }
+bool keyboard_check_pressed_Y() { return PLATFORM(keyboard_check_pressed_Y)(); }
+
+bool keyboard_check_pressed_L() { return PLATFORM(keyboard_check_pressed_L)(); }
+bool keyboard_check_pressed_R() { return PLATFORM(keyboard_check_pressed_R)(); }
+
+bool keyboard_check_pressed_start() { return PLATFORM(keyboard_check_pressed_start)(); }
+bool keyboard_check_pressed_select() { return PLATFORM(keyboard_check_pressed_select)(); }
\ No newline at end of file
@@ -1,117 +1,228 @@
+#include <cstdint>
+#include <cstring>
 #include <platform/graphics_layer.h>
+
+#ifdef __SWITCH__
 #include <platform/switch/graphics_layer_switch.h>
+#define PLATFORM(function) function##_switch
+#else
+#include <platform/pc/graphics_layer_pc.h>
+#define PLATFORM(function) function##_pc
+#endif
+
+// Running hash of every draw call made this frame. When it matches the previous
+// frame for as many frames as there are framebuffers, every buffer in the swapchain
+// already holds this exact image and the frame can be presented without drawing.
+static uint64_t frame_signature = 0;
+static uint64_t previous_frame_signature = 0;
+static int unchanged_frames = 0;
+static bool reuse_unchanged_frames = true;
+
+static void sign_bytes(const void* data, size_t size)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; i++)
+	{
+		frame_signature ^= bytes[i];
+		frame_signature *= 1099511628211ULL;
+	}
+}
+
+template <typename T>
+static void sign(T value)
+{
+	sign_bytes(&value, sizeof(value));
+}
+
+static void sign_text(const char* text)
+{
+	sign_bytes(text, strlen(text) + 1);
+}
 
 void initialize_graphics(unsigned int width, unsigned int height)
 {
-	initialize_graphics_switch(width, height);
+	PLATFORM(initialize_graphics)(width, height);
+}
+
+SpriteId load_sprite(std::string sprite_name, std::string filename)
+{
+	return SpriteId{ PLATFORM(load_sprite)(sprite_name, filename) };
 }
 
-void load_sprite(std::string sprite_name, std::string filename)
+bool draw_sprite(float x, float y, float width, float height, SpriteId sprite)
 {
-	load_sprite_switch(sprite_name, filename);
+	sign(1); sign(x); sign(y); sign(width); sign(height); sign(sprite.index);
+	return PLATFORM(draw_sprite)(x, y, width, height, sprite.index);
 }
 
 bool draw_sprite(float x, float y, float width, float height, std::string sprite_name)
 {
-	return draw_sprite_switch(x, y, width, height, sprite_name);
+	sign(2); sign(x); sign(y); sign(width); sign(height); sign_text(sprite_name.c_str());
+	return PLATFORM(draw_sprite)(x, y, width, height, sprite_name);
+}
+
+void draw_cell_grid(float x, float y, float cell_width, float cell_height, const Grid& grid, SpriteId cell_on, SpriteId cell_off)
+{
+	sign(3); sign(x); sign(y); sign(cell_width); sign(cell_height); sign(cell_on.index); sign(cell_off.index);
+	sign(grid.width); sign(grid.height);
+	sign_bytes(grid.rows(), sizeof(uint64_t) * grid.height);
+	PLATFORM(draw_cell_grid)(x, y, cell_width, cell_height, grid, cell_on.index, cell_off.index);
+}
+
+FontId load_font(std::string font_name, std::string filename)
+{
+	return FontId{ PLATFORM(load_font)(font_name, filename) };
 }
 
-void load_fonts()
+void add_fallback_font(FontId font, FontId fallback)
 {
-	load_fonts_switch();
+	if (font.valid() && fallback.valid())
+		PLATFORM(add_fallback_font)(font.index, fallback.index);
 }
 
 void exit_graphics()
 {
-	exit_graphics_switch();
+	PLATFORM(exit_graphics)();
 }
 
 void push_graphics()
 {
-	push_graphics_switch();
+	sign(4);
+	PLATFORM(push_graphics)();
 }
 
 void gfx_translate(float x, float y)
 {
-	gfx_translate_switch(x, y);
+	sign(5); sign(x); sign(y);
+	PLATFORM(gfx_translate)(x, y);
 }
 
 void gfx_scale(float x, float y)
 {
-	gfx_scale_switch(x, y);
+	sign(6); sign(x); sign(y);
+	PLATFORM(gfx_scale)(x, y);
 }
 
 void gfx_rotate(float angle)
 {
-	gfx_rotate_switch(angle);
+	sign(7); sign(angle);
+	PLATFORM(gfx_rotate)(angle);
 }
 
 void pop_graphics()
 {
-	pop_graphics_switch();
+	sign(8);
+	PLATFORM(pop_graphics)();
+}
+
+void set_font(FontId font)
+{
+	sign(9); sign(font.index);
+	PLATFORM(set_font)(font.index);
 }
 
 void set_font(std::string font_name)
 {
-	set_font_switch(font_name);
+	sign(10); sign_text(font_name.c_str());
+	PLATFORM(set_font)(font_name);
 }
 
 void set_font_size(float size)
 {
-	set_font_size_switch(size);
+	sign(11); sign(size);
+	PLATFORM(set_font_size)(size);
 }
 
 void set_text_align(int alignment)
 {
-	set_text_align_switch(alignment);
+	sign(12); sign(alignment);
+	PLATFORM(set_text_align)(alignment);
 }
 
 void draw_set_fill_color(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
 {
-	draw_set_fill_color_switch(r, g, b, a);
+	sign(13); sign(r); sign(g); sign(b); sign(a);
+	PLATFORM(draw_set_fill_color)(r, g, b, a);
+}
+
+void draw_text(float x, float y, const char* text)
+{
+	sign(14); sign(x); sign(y); sign_text(text);
+	PLATFORM(draw_text)(x, y, text);
+}
+
+void draw_text(float x, float y, const std::string& text)
+{
+	draw_text(x, y, text.c_str());
 }
 
-void draw_text(float x, float y, std::string text)
+void draw_text_width(float x, float y, float line_break, const char* text)
 {
-	draw_text_switch(x, y, text);
+	sign(15); sign(x); sign(y); sign(line_break); sign_text(text);
+	PLATFORM(draw_text_width)(x, y, line_break, text);
 }
 
-void draw_text_width(float x, float y, float line_break, std::string text)
+void draw_text_width(float x, float y, float line_break, const std::string& text)
 {
-	draw_text_width_switch(x, y, line_break, text);
+	draw_text_width(x, y, line_break, text.c_str());
 }
 
 void gfx_start_frame()
 {
-	gfx_start_frame_switch();
+	frame_signature = 14695981039346656037ULL;
+	PLATFORM(gfx_start_frame)();
 }
 
 void gfx_end_frame()
 {
-	gfx_end_frame_switch();
+	if (frame_signature == previous_frame_signature)
+		unchanged_frames += 1;
+	else
+		unchanged_frames = 0;
+	previous_frame_signature = frame_signature;
+
+	bool redraw = !reuse_unchanged_frames || unchanged_frames < PLATFORM(gfx_framebuffer_count)();
+	PLATFORM(gfx_end_frame)(redraw);
+}
+
+void gfx_set_reuse_unchanged_frames(bool reuse)
+{
+	reuse_unchanged_frames = reuse;
+	unchanged_frames = 0;
 }
 
 void draw_rounded_rect(float x, float y, float w, float h, float radius, unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha)
 {
-	draw_rounded_rect_switch(x, y, w, h, radius, red, green, blue, alpha);
+	sign(16); sign(x); sign(y); sign(w); sign(h); sign(radius); sign(red); sign(green); sign(blue); sign(alpha);
+	PLATFORM(draw_rounded_rect)(x, y, w, h, radius, red, green, blue, alpha);
 }
 
 void draw_rect(float x, float y, float w, float h, unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha)
 {
-	draw_rect_switch(x, y, w, h, red, green, blue, alpha);
+	sign(17); sign(x); sign(y); sign(w); sign(h); sign(red); sign(green); sign(blue); sign(alpha);
+	PLATFORM(draw_rect)(x, y, w, h, red, green, blue, alpha);
+}
+
+void draw_set_font(FontId font)
+{
+	sign(18); sign(font.index);
+	PLATFORM(draw_set_font)(font.index);
 }
 
 void draw_set_font(std::string fontname)
 {
-	draw_set_font_switch(fontname);
+	sign(19); sign_text(fontname.c_str());
+	PLATFORM(draw_set_font)(fontname);
 }
 
 void draw_set_font_size(float size)
 {
-	draw_set_font_size_switch(size);
+	sign(20); sign(size);
+	PLATFORM(draw_set_font_size)(size);
 }
 
 void draw_set_font_align(int align)
 {
-	draw_set_font_align_switch(align);
+	sign(21); sign(align);
+	PLATFORM(draw_set_font_align)(align);
 }
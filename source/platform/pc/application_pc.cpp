@@ -0,0 +1,43 @@
+#include <platform/pc/application_pc.h>
+
+static std::string config_path = "./config/brickgame/";
+
+CApplication::CApplication()
+{
+	time_ns = 0;
+}
+
+CApplication::~CApplication()
+{
+}
+
+void CApplication::run()
+{
+	while (run_frames(1))
+	{
+	}
+}
+
+bool CApplication::run_frames(unsigned int frame_count)
+{
+	for (unsigned int i = 0; i < frame_count; i++)
+	{
+		time_ns += frame_time_ns;
+		if (!onFrame(time_ns))
+			return false;
+	}
+
+	return true;
+}
+
+void set_config_path_pc(const std::string& path)
+{
+	config_path = path;
+	if (config_path.empty() || config_path.back() != '/')
+		config_path += '/';
+}
+
+const std::string& config_path_pc()
+{
+	return config_path;
+}
@@ -0,0 +1,36 @@
+#include <platform/pc/audio_layer_pc.h>
+
+static unsigned int sounds_played = 0;
+static bool sounds_enabled = true;
+
+unsigned int sounds_played_pc()
+{
+	return sounds_played;
+}
+
+bool init_audio_pc()
+{
+	sounds_played = 0;
+	sounds_enabled = true;
+	return false;
+}
+
+bool exit_audio_pc()
+{
+	return false;
+}
+
+void play_sound_pc(const char* sound_name)
+{
+	if (sounds_enabled)
+		sounds_played += 1;
+}
+
+void set_music_enabled_pc(bool enabled)
+{
+}
+
+void set_sounds_enabled_pc(bool enabled)
+{
+	sounds_enabled = enabled;
+}
@@ -0,0 +1,79 @@
+#include <platform/pc/control_layer_pc.h>
+
+class control_lib_pc
+{
+public:
+	std::function<unsigned int(unsigned int frame)> script;
+	unsigned int frame = 0;
+	unsigned int held = 0;
+	unsigned int previous = 0;
+};
+
+static control_lib_pc CTL;
+
+static bool check(unsigned int button)
+{
+	return (CTL.held & button) != 0;
+}
+
+static bool check_pressed(unsigned int button)
+{
+	return (CTL.held & ~CTL.previous & button) != 0;
+}
+
+void set_input_script_pc(std::function<unsigned int(unsigned int frame)> script)
+{
+	CTL.script = script;
+}
+
+void set_held_buttons_pc(unsigned int buttons)
+{
+	CTL.script = nullptr;
+	CTL.held = buttons;
+}
+
+void init_controllers_pc()
+{
+	CTL.frame = 0;
+	CTL.held = 0;
+	CTL.previous = 0;
+}
+
+void update_controllers_pc()
+{
+	CTL.previous = CTL.held;
+	if (CTL.script)
+		CTL.held = CTL.script(CTL.frame);
+	CTL.frame += 1;
+}
+
+bool keyboard_check_right_pc() { return check(pc_button_right); }
+bool keyboard_check_up_pc() { return check(pc_button_up); }
+bool keyboard_check_left_pc() { return check(pc_button_left); }
+bool keyboard_check_down_pc() { return check(pc_button_down); }
+
+bool keyboard_check_L_pc() { return check(pc_button_L); }
+bool keyboard_check_R_pc() { return check(pc_button_R); }
+bool keyboard_check_ZL_pc() { return check(pc_button_ZL); }
+bool keyboard_check_ZR_pc() { return check(pc_button_ZR); }
+
+bool keyboard_check_A_pc() { return check(pc_button_A); }
+bool keyboard_check_B_pc() { return check(pc_button_B); }
+bool keyboard_check_X_pc() { return check(pc_button_X); }
+bool keyboard_check_Y_pc() { return check(pc_button_Y); }
+
+bool keyboard_check_pressed_right_pc() { return check_pressed(pc_button_right); }
+bool keyboard_check_pressed_up_pc() { return check_pressed(pc_button_up); }
+bool keyboard_check_pressed_left_pc() { return check_pressed(pc_button_left); }
+bool keyboard_check_pressed_down_pc() { return check_pressed(pc_button_down); }
+
+bool keyboard_check_pressed_A_pc() { return check_pressed(pc_button_A); }
+bool keyboard_check_pressed_B_pc() { return check_pressed(pc_button_B); }
+bool keyboard_check_pressed_X_pc() { return check_pressed(pc_button_X); }
+bool keyboard_check_pressed_Y_pc() { return check_pressed(pc_button_Y); }
+
+bool keyboard_check_pressed_L_pc() { return check_pressed(pc_button_L); }
+bool keyboard_check_pressed_R_pc() { return check_pressed(pc_button_R); }
+
+bool keyboard_check_pressed_start_pc() { return check_pressed(pc_button_start); }
+bool keyboard_check_pressed_select_pc() { return check_pressed(pc_button_select); }
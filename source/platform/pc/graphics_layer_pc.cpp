@@ -1,6 +1,295 @@
+#include <cstdio>
+#include <cstring>
+#include <map>
 #include <platform/pc/graphics_layer_pc.h>
+#include <utils/log.h>
+
+class graph_lib_pc
+{
+public:
+	std::map<std::string, int> sprite_indicies;
+	std::map<std::string, int> font_indicies;
+
+	// Recording goes into frame_*, a redrawn frame is swapped into presented_*.
+	// Both keep their capacity, so steady state recording doesn't allocate.
+	std::vector<gfx_command_pc> frame_commands;
+	std::vector<char> frame_text;
+	std::vector<gfx_command_pc> presented_commands;
+	std::vector<char> presented_text;
+
+	unsigned int frames_presented = 0;
+	unsigned int frames_redrawn = 0;
+};
+
+static graph_lib_pc GL;
+
+static gfx_command_pc& record(gfx_command_type_pc type)
+{
+	GL.frame_commands.emplace_back();
+	gfx_command_pc& command = GL.frame_commands.back();
+	memset(&command, 0, sizeof(command));
+	command.type = type;
+	return command;
+}
+
+static void record_text(gfx_command_pc& command, const char* text)
+{
+	command.text_offset = GL.frame_text.size();
+	GL.frame_text.insert(GL.frame_text.end(), text, text + strlen(text) + 1);
+}
+
+static void record_color(gfx_command_pc& command, unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	command.color[0] = r;
+	command.color[1] = g;
+	command.color[2] = b;
+	command.color[3] = a;
+}
+
+const std::vector<gfx_command_pc>& gfx_frame_commands_pc()
+{
+	return GL.presented_commands;
+}
+
+const char* gfx_command_text_pc(const gfx_command_pc& command)
+{
+	return GL.presented_text.data() + command.text_offset;
+}
+
+unsigned int gfx_frames_presented_pc()
+{
+	return GL.frames_presented;
+}
+
+unsigned int gfx_frames_redrawn_pc()
+{
+	return GL.frames_redrawn;
+}
 
 void initialize_graphics_pc(unsigned int width, unsigned int height)
 {
+	GL.frame_commands.reserve(1024);
+	GL.frame_text.reserve(4096);
+	GL.presented_commands.reserve(1024);
+	GL.presented_text.reserve(4096);
+}
+
+int load_font_pc(std::string font_name, std::string font_path)
+{
+	auto found = GL.font_indicies.find(font_name);
+	if (found != GL.font_indicies.end())
+		return found->second;
 
-}
\ No newline at end of file
+	int font_handle = GL.font_indicies.size();
+	GL.font_indicies[font_name] = font_handle;
+	return font_handle;
+}
+
+void add_fallback_font_pc(int font_handle, int fallback_handle)
+{
+}
+
+void exit_graphics_pc()
+{
+	GL.frame_commands.clear();
+	GL.presented_commands.clear();
+}
+
+void push_graphics_pc()
+{
+	record(gfx_command_push);
+}
+
+void gfx_translate_pc(float x, float y)
+{
+	gfx_command_pc& command = record(gfx_command_translate);
+	command.args[0] = x;
+	command.args[1] = y;
+}
+
+void gfx_scale_pc(float x, float y)
+{
+	gfx_command_pc& command = record(gfx_command_scale);
+	command.args[0] = x;
+	command.args[1] = y;
+}
+
+void gfx_rotate_pc(float angle)
+{
+	gfx_command_pc& command = record(gfx_command_rotate);
+	command.args[0] = angle;
+}
+
+void pop_graphics_pc()
+{
+	record(gfx_command_pop);
+}
+
+void set_font_pc(std::string font_name)
+{
+	auto found = GL.font_indicies.find(font_name);
+	set_font_pc((found != GL.font_indicies.end()) ? found->second : -1);
+}
+
+void set_font_pc(int font_handle)
+{
+	gfx_command_pc& command = record(gfx_command_font);
+	command.handle = font_handle;
+}
+
+void set_font_size_pc(float size)
+{
+	gfx_command_pc& command = record(gfx_command_font_size);
+	command.args[0] = size;
+}
+
+void set_text_align_pc(int alignment)
+{
+	gfx_command_pc& command = record(gfx_command_text_align);
+	command.handle = alignment;
+}
+
+void draw_set_fill_color_pc(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	gfx_command_pc& command = record(gfx_command_fill_color);
+	record_color(command, r, g, b, a);
+}
+
+void draw_text_pc(float x, float y, const char* text)
+{
+	gfx_command_pc& command = record(gfx_command_text);
+	command.args[0] = x;
+	command.args[1] = y;
+	record_text(command, text);
+}
+
+void draw_text_width_pc(float x, float y, float line_break, const char* text)
+{
+	gfx_command_pc& command = record(gfx_command_text_box);
+	command.args[0] = x;
+	command.args[1] = y;
+	command.args[2] = line_break;
+	record_text(command, text);
+}
+
+int load_sprite_pc(std::string sprite_name, std::string sprite_path)
+{
+	auto found = GL.sprite_indicies.find(sprite_name);
+	if (found != GL.sprite_indicies.end())
+		return found->second;
+
+	// Handles start at 1, 0 means not loaded like on the Switch
+	int sprite_handle = GL.sprite_indicies.size() + 1;
+	GL.sprite_indicies[sprite_name] = sprite_handle;
+	return sprite_handle;
+}
+
+bool draw_sprite_pc(float x, float y, float width, float height, std::string sprite_name)
+{
+	auto found = GL.sprite_indicies.find(sprite_name);
+	if (found == GL.sprite_indicies.end())
+	{
+		LOG_WARN(log_gfx, "Trying to draw unloaded sprite, %s", sprite_name.c_str());
+		return false;
+	}
+
+	return draw_sprite_pc(x, y, width, height, found->second);
+}
+
+bool draw_sprite_pc(float x, float y, float width, float height, int sprite_handle)
+{
+	if (sprite_handle == 0)
+		return false;
+
+	gfx_command_pc& command = record(gfx_command_sprite);
+	command.args[0] = x;
+	command.args[1] = y;
+	command.args[2] = width;
+	command.args[3] = height;
+	command.handle = sprite_handle;
+	return true;
+}
+
+void draw_cell_grid_pc(float x, float y, float cell_width, float cell_height, const Grid& grid, int cell_on, int cell_off)
+{
+	if (cell_on == 0 || cell_off == 0)
+		return;
+
+	const uint64_t* rows = grid.rows();
+	int lit = 0;
+	for (int j = 0; j < grid.height; j++)
+		lit += __builtin_popcountll(rows[j]);
+
+	gfx_command_pc& command = record(gfx_command_cell_grid);
+	command.args[0] = x;
+	command.args[1] = y;
+	command.args[2] = cell_width;
+	command.args[3] = cell_height;
+	command.handle = cell_on;
+	command.handle_off = cell_off;
+	command.count = lit;
+}
+
+void gfx_start_frame_pc()
+{
+	GL.frame_commands.clear();
+	GL.frame_text.clear();
+}
+
+void gfx_end_frame_pc(bool redraw)
+{
+	if (redraw)
+	{
+		GL.presented_commands.swap(GL.frame_commands);
+		GL.presented_text.swap(GL.frame_text);
+		GL.frames_redrawn += 1;
+	}
+
+	GL.frames_presented += 1;
+}
+
+int gfx_framebuffer_count_pc()
+{
+	return 1;
+}
+
+void draw_rounded_rect_pc(float x, float y, float w, float h, float radius, unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha)
+{
+	gfx_command_pc& command = record(gfx_command_rounded_rect);
+	command.args[0] = x;
+	command.args[1] = y;
+	command.args[2] = w;
+	command.args[3] = h;
+	command.args[4] = radius;
+	record_color(command, red, green, blue, alpha);
+}
+
+void draw_rect_pc(float x, float y, float w, float h, unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha)
+{
+	gfx_command_pc& command = record(gfx_command_rect);
+	command.args[0] = x;
+	command.args[1] = y;
+	command.args[2] = w;
+	command.args[3] = h;
+	record_color(command, red, green, blue, alpha);
+}
+
+void draw_set_font_pc(std::string fontname)
+{
+	set_font_pc(fontname);
+}
+
+void draw_set_font_pc(int font_handle)
+{
+	set_font_pc(font_handle);
+}
+
+void draw_set_font_size_pc(float size)
+{
+	set_font_size_pc(size);
+}
+
+void draw_set_font_align_pc(int align)
+{
+	set_text_align_pc(align);
+}
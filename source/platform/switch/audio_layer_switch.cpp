@@ -1,30 +1,30 @@
 #include <SDL.h>
 #include <SDL_mixer.h>
 #include <stdio.h>
-#include "audio.h"
 #include <vector>
 #include <map>
 #include <string>
-#include <settings.h>
+#include <platform/switch/audio_layer_switch.h>
+#include <utils/log.h>
 
 std::map<std::string, Mix_Chunk*> audio_files;
 Mix_Music* music;
 
-bool init_audio()
+bool init_audio_switch()
 {
-	printf("SDL stuff\n");
+	LOG_DEBUG(log_audio, "SDL stuff");
 	// Start SDL with audio support
 	int i = SDL_Init(SDL_INIT_AUDIO);
-	printf("%i\n", i);
+	LOG_DEBUG(log_audio, "%i", i);
 
 	// Load support for the MP3 format
 	i = Mix_Init(MIX_INIT_MP3);
-	printf("%i\n", i);
+	LOG_DEBUG(log_audio, "%i", i);
 
 	// open 44.1KHz, signed 16bit, system byte order,
 	//  stereo audio, using 4096 byte chunks
 	i = Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, 4096);
-	printf("%i\n", i);
+	LOG_DEBUG(log_audio, "%i", i);
 
 	// Load sound file to use
 	audio_files["sfx_movement_footsteps5"] = Mix_LoadWAV("romfs:/audio/sfx_movement_footsteps5.wav");
@@ -37,26 +37,10 @@ bool init_audio()
 	music = Mix_LoadMUS("romfs:/audio/chipscape.mp3");
 	Mix_PlayMusic(music, -1);
 
-	//
-
-	if (!settings_get_value_true("temp_prefs", "music_bool"))
-	{
-		Mix_VolumeMusic(0);
-		settings_set_value("temp_prefs", "music_bool", "false");
-	}
-
-	if (!settings_get_value_true("temp_prefs", "sound_bool"))
-	{
-		for (auto const& [key, val] : audio_files)
-			Mix_VolumeChunk(val, 0);
-	}
-
-	//
-
 	return false;
 }
 
-bool exit_audio()
+bool exit_audio_switch()
 {
 	for (auto const& [key, val] : audio_files)
 	{
@@ -70,3 +54,21 @@ bool exit_audio()
 
 	return false;
 }
+
+void play_sound_switch(const char* sound_name)
+{
+	auto found = audio_files.find(sound_name);
+	if (found != audio_files.end())
+		Mix_PlayChannel(-1, found->second, 0);
+}
+
+void set_music_enabled_switch(bool enabled)
+{
+	Mix_VolumeMusic(enabled ? 128 : 0);
+}
+
+void set_sounds_enabled_switch(bool enabled)
+{
+	for (auto const& [key, val] : audio_files)
+		Mix_VolumeChunk(val, enabled ? 32 : 0);
+}
@@ -2,6 +2,7 @@
 #include <nanovg_dk.h>
 #include <string>
 #include <platform/switch/graphics_layer_switch.h>
+#include <utils/log.h>
 
 class graph_lib
 {
@@ -159,7 +160,7 @@ void initialize_graphics_switch(unsigned int width, unsigned int height)
 	GL.cmdbuf = dk::CmdBufMaker{ GL.device }.create();
 	CMemPool::Handle cmdmem = GL.pool_data->allocate(GL.StaticCmdSize);
 	GL.cmdbuf.addMemory(cmdmem.getMemBlock(), cmdmem.getOffset(), cmdmem.getSize());
-	printf("cmdmem size: %u\n", cmdmem.getSize());
+	LOG_DEBUG(log_gfx, "cmdmem size: %u", (unsigned int)cmdmem.getSize());
 	// Create the framebuffer resources
 	createFramebufferResources();
 
@@ -167,43 +168,18 @@ void initialize_graphics_switch(unsigned int width, unsigned int height)
 	GL.vg = nvgCreateDk(&*GL.renderer, NVG_DEBUG);
 }
 
-void load_fonts_switch()
+int load_font_switch(std::string font_name, std::string font_path)
 {
-	int fontIcons = nvgCreateFont(GL.vg, "icons", "romfs:/fonts/entypo.ttf");
-	if (fontIcons == -1) {
-		printf("Could not add font icons.\n");
-	}
-	int fontNormal = nvgCreateFont(GL.vg, "sans", "romfs:/fonts/Roboto-Regular.ttf");
-	if (fontNormal == -1) {
-		printf("Could not add font italic.\n");
-	}
-	int fontBold = nvgCreateFont(GL.vg, "sans-bold", "romfs:/fonts/Roboto-Bold.ttf");
-	if (fontBold == -1) {
-		printf("Could not add font bold.\n");
-	}
-	int fontEmoji = nvgCreateFont(GL.vg, "emoji", "romfs:/fonts/NotoEmoji-Regular.ttf");
-	if (fontEmoji == -1) {
-		printf("Could not add font emoji.\n");
-	}
-	int fontSegment = nvgCreateFont(GL.vg, "seg", "romfs:/fonts/DSEG7Classic-Bold.ttf");
-	if (fontSegment == -1) {
-		printf("Could not add font segment.\n");
-	}
-	int fontMinecraft = nvgCreateFont(GL.vg, "minecraft", "romfs:/fonts/Minecraft.ttf");
-	if (fontMinecraft == -1) {
-		printf("Could not add font minecraft.\n");
-	}
-	int fontKongtext = nvgCreateFont(GL.vg, "kongtext", "romfs:/fonts/kongtext-regular.ttf");
-	if (fontKongtext == -1) {
-		printf("Could not add font Kongtext.\n");
-	}
-	int vcrtext = nvgCreateFont(GL.vg, "vcrtext", "romfs:/fonts/VCR_OSD_MONO_1.ttf");
-	if (vcrtext == -1) {
-		printf("Could not add font vcrtext.\n");
-	}
+	int font_handle = nvgCreateFont(GL.vg, font_name.c_str(), font_path.c_str());
+	if (font_handle == -1)
+		LOG_WARN(log_gfx, "Could not add font %s", font_name.c_str());
+
+	return font_handle;
+}
 
-	nvgAddFallbackFontId(GL.vg, fontNormal, fontEmoji);
-	nvgAddFallbackFontId(GL.vg, fontBold, fontEmoji);
+void add_fallback_font_switch(int font_handle, int fallback_handle)
+{
+	nvgAddFallbackFontId(GL.vg, font_handle, fallback_handle);
 }
 
 void exit_graphics_switch()
@@ -248,6 +224,11 @@ void set_font_switch(std::string font_name)
 	nvgFontFace(GL.vg, font_name.c_str());
 }
 
+void set_font_switch(int font_handle)
+{
+	nvgFontFaceId(GL.vg, font_handle);
+}
+
 void set_font_size_switch(float size)
 {
 	nvgFontSize(GL.vg, size);
@@ -263,48 +244,98 @@ void draw_set_fill_color_switch(unsigned char r, unsigned char g, unsigned char
 	nvgFillColor(GL.vg, nvgRGBA(r, g, b, a));
 }
 
-void draw_text_switch(float x, float y, std::string text)
+void draw_text_switch(float x, float y, const char* text)
 {
-	nvgText(GL.vg, x, y, text.c_str(), NULL);
+	nvgText(GL.vg, x, y, text, NULL);
 }
 
-void draw_text_width_switch(float x, float y, float line_break, std::string text)
+void draw_text_width_switch(float x, float y, float line_break, const char* text)
 {
-	nvgTextBox(GL.vg, x, y, line_break, text.c_str(), NULL);
+	nvgTextBox(GL.vg, x, y, line_break, text, NULL);
 }
 
 std::map<std::string, int> sprite_indicies;
 
-void load_sprite_switch(std::string sprite_name, std::string sprite_path)
+int load_sprite_switch(std::string sprite_name, std::string sprite_path)
 {
-	sprite_indicies[sprite_name] = nvgCreateImage(GL.vg, sprite_path.c_str(), NVG_IMAGE_NEAREST);
+	// Repeating so a single image pattern can tile a whole board of cells
+	sprite_indicies[sprite_name] = nvgCreateImage(GL.vg, sprite_path.c_str(), NVG_IMAGE_NEAREST | NVG_IMAGE_REPEATX | NVG_IMAGE_REPEATY);
 	if (sprite_indicies[sprite_name] == 0)
-		printf(("Problem loading " + sprite_name + "\n").c_str());
+		LOG_WARN(log_gfx, "Problem loading %s", sprite_name.c_str());
 	else
-		printf(("Loaded " + sprite_name + " to index " + std::to_string(sprite_indicies[sprite_name]) + "\n").c_str());
+		LOG_DEBUG(log_gfx, "Loaded %s to index %i", sprite_name.c_str(), sprite_indicies[sprite_name]);
+
+	return sprite_indicies[sprite_name];
 }
 
 bool draw_sprite_switch(float x, float y, float width, float height, std::string sprite_name)
 {
 	if (sprite_indicies.count(sprite_name) == 0)
 	{
-		printf(("Trying to draw unloaded sprite, " + sprite_name + "\n").c_str());
+		LOG_WARN(log_gfx, "Trying to draw unloaded sprite, %s", sprite_name.c_str());
 		return false;
 	}
 	else
 	{
 		//printf(("Trying to draw loaded sprite, " + sprite_name + "\n").c_str());
-		nvgSave(GL.vg);
-		nvgScissor(GL.vg, x, y, width, height);
-		nvgTranslate(GL.vg, x, y);
-
-		NVGpaint imgPaint = nvgImagePattern(GL.vg, 0, 0, width, height, 0.0f / 180.0f * NVG_PI, sprite_indicies[sprite_name], 1.0f);
-		nvgBeginPath(GL.vg);
-		nvgRect(GL.vg, 0, 0, width, height);
-		nvgFillPaint(GL.vg, imgPaint);
+		return draw_sprite_switch(x, y, width, height, sprite_indicies[sprite_name]);
+	}
+}
+
+bool draw_sprite_switch(float x, float y, float width, float height, int sprite_handle)
+{
+	if (sprite_handle == 0)
+		return false;
+
+	nvgSave(GL.vg);
+	nvgScissor(GL.vg, x, y, width, height);
+	nvgTranslate(GL.vg, x, y);
+
+	NVGpaint imgPaint = nvgImagePattern(GL.vg, 0, 0, width, height, 0.0f / 180.0f * NVG_PI, sprite_handle, 1.0f);
+	nvgBeginPath(GL.vg);
+	nvgRect(GL.vg, 0, 0, width, height);
+	nvgFillPaint(GL.vg, imgPaint);
+	nvgFill(GL.vg);
+	nvgRestore(GL.vg);
+	return true;
+}
+
+void draw_cell_grid_switch(float x, float y, float cell_width, float cell_height, const Grid& grid, int cell_on, int cell_off)
+{
+	if (cell_on == 0 || cell_off == 0)
+		return;
+
+	// Every cell starts unlit: one rect, the pattern repeats once per cell
+	nvgBeginPath(GL.vg);
+	nvgRect(GL.vg, x, y, cell_width * grid.width, cell_height * grid.height);
+	nvgFillPaint(GL.vg, nvgImagePattern(GL.vg, x, y, cell_width, cell_height, 0.0f, cell_off, 1.0f));
+	nvgFill(GL.vg);
+
+	// Lit cells go on top as one path, a rect per horizontal run of set bits
+	const uint64_t* rows = grid.rows();
+	bool any_lit = false;
+
+	nvgBeginPath(GL.vg);
+	for (int j = 0; j < grid.height; j++)
+	{
+		uint64_t row = rows[j];
+		while (row != 0)
+		{
+			int start = __builtin_ctzll(row);
+			uint64_t run = row >> start;
+			int length = (~run == 0) ? 64 - start : __builtin_ctzll(~run);
+
+			nvgRect(GL.vg, x + start * cell_width, y + j * cell_height, length * cell_width, cell_height);
+			any_lit = true;
+
+			row &= (start + length >= 64) ? 0 : (~(uint64_t)0 << (start + length));
+		}
+	}
+
+	if (any_lit)
+	{
+		nvgFillPaint(GL.vg, nvgImagePattern(GL.vg, x, y, cell_width, cell_height, 0.0f, cell_on, 1.0f));
 		nvgFill(GL.vg);
-		nvgRestore(GL.vg);
-		return true;
 	}
 }
 
@@ -313,23 +344,36 @@ void gfx_start_frame_switch()
 	// Acquire a framebuffer from the swapchain (and wait for it to be available)
 	GL.slot = GL.queue.acquireImage(GL.swapchain);
 
-	// Run the command list that attaches said framebuffer to the queue
-	GL.queue.submitCommands(GL.framebuffer_cmdlists[GL.slot]);
-
-	// Run the main rendering command list
-	GL.queue.submitCommands(GL.render_cmdlist);
-
 	nvgBeginFrame(GL.vg, GL.FramebufferWidth, GL.FramebufferHeight, 1.0f);
 }
 
-void gfx_end_frame_switch()
+void gfx_end_frame_switch(bool redraw)
 {
-	nvgEndFrame(GL.vg);
+	if (redraw)
+	{
+		// Run the command list that attaches said framebuffer to the queue
+		GL.queue.submitCommands(GL.framebuffer_cmdlists[GL.slot]);
+
+		// Run the main rendering command list
+		GL.queue.submitCommands(GL.render_cmdlist);
+
+		nvgEndFrame(GL.vg);
+	}
+	else
+	{
+		// The framebuffer still holds this exact frame, skip the clear and the draw
+		nvgCancelFrame(GL.vg);
+	}
 
 	// Now that we are done rendering, present it to the screen
 	GL.queue.presentImage(GL.swapchain, GL.slot);
 }
 
+int gfx_framebuffer_count_switch()
+{
+	return GL.NumFramebuffers;
+}
+
 void draw_rounded_rect_switch(float x, float y, float w, float h, float radius, unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha)
 {
 	nvgBeginPath(GL.vg);
@@ -351,6 +395,11 @@ void draw_set_font_switch(std::string fontname)
 	nvgFontFace(GL.vg, fontname.c_str());
 }
 
+void draw_set_font_switch(int font_handle)
+{
+	nvgFontFaceId(GL.vg, font_handle);
+}
+
 void draw_set_font_size_switch(float size)
 {
 	nvgFontSize(GL.vg, size);
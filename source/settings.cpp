@@ -1,4 +1,5 @@
 #include <settings.h>
+#include <utils/safe_file.h>
 
 #include <filesystem>
 #include <fstream>
@@ -6,63 +7,166 @@
 #include <string>
 #include <vector>
 #include <utils.hpp>
+#include <utils/log.h>
 
 namespace fs = std::filesystem;
 
 nlohmann::json settings_json;
+settings_cache settings;
+
+static bool settings_dirty = false;
+
+enum setting_type
+{
+	setting_bool,
+	setting_int,
+	setting_string,
+};
+
+struct setting_entry
+{
+	const char* category;
+	const char* key;
+	setting_type type;
+	void* field;
+};
+
+// Every cached setting and where it lives in settings.json. Values are stored as
+// strings in the file, the same as before the cache existed.
+static const setting_entry setting_entries[] =
+{
+	{ "meta", "debug", setting_bool, &settings.debug },
+	{ "temp_prefs", "music_bool", setting_bool, &settings.music },
+	{ "temp_prefs", "sound_bool", setting_bool, &settings.sound },
+	{ "history", "last seen version", setting_string, &settings.last_seen_version },
+};
+
+static const setting_entry* find_setting(const std::string& category, const std::string& key)
+{
+	for (const setting_entry& entry : setting_entries)
+		if (category == entry.category && key == entry.key)
+			return &entry;
+	return NULL;
+}
+
+static std::string setting_to_string(const setting_entry& entry)
+{
+	switch (entry.type)
+	{
+	case setting_bool: return *(bool*)entry.field ? "true" : "false";
+	case setting_int: return std::to_string(*(int*)entry.field);
+	default: return *(std::string*)entry.field;
+	}
+}
+
+static void setting_from_string(const setting_entry& entry, const std::string& value)
+{
+	switch (entry.type)
+	{
+	case setting_bool: *(bool*)entry.field = (value == "true"); break;
+	case setting_int: *(int*)entry.field = atoi(value.c_str()); break;
+	default: *(std::string*)entry.field = value; break;
+	}
+}
+
+// Copies settings_json into the cache. Keys missing from the file keep their defaults
+// and get written out on the next save.
+static void hydrate_settings()
+{
+	for (const setting_entry& entry : setting_entries)
+	{
+		auto category = settings_json.find(entry.category);
+		if (category != settings_json.end() && category->is_object())
+		{
+			auto value = category->find(entry.key);
+			if (value != category->end() && value->is_string())
+			{
+				setting_from_string(entry, value->get_ref<const std::string&>());
+				continue;
+			}
+		}
+		settings_dirty = true;
+	}
+}
 
 void read_settings()
 {
-	if (std::filesystem::exists(get_settings_path()))
+	std::string contents;
+	if (safe_read_file(get_settings_path(), contents))
 	{
-		std::ifstream file(get_settings_path());
-		settings_json = nlohmann::json::parse(file);
+		settings_json = nlohmann::json::parse(contents, nullptr, false);
+		if (settings_json.is_discarded() && safe_read_single_file(get_settings_path() + ".bak", contents))
+			settings_json = nlohmann::json::parse(contents, nullptr, false);
+		if (settings_json.is_discarded())
+		{
+			print_debug("Settings json unreadable, starting fresh.");
+			settings_json = nlohmann::json::object();
+		}
 	}
 	else
 		print_debug("Settings json not found.");
+
+	hydrate_settings();
 }
 
 void save_settings()
 {
+	for (const setting_entry& entry : setting_entries)
+		settings_json[entry.category][entry.key] = setting_to_string(entry);
+
+	// Stays dirty if the write fails, so the next flush tries again
 	create_directories(get_config_path());
-	std::ofstream o(get_settings_path());
-	o << settings_json << std::endl;
+	if (safe_write_file(get_settings_path(), settings_json.dump()))
+		settings_dirty = false;
 	print_debug("Saving settings");
 }
 
-void settings_set_value(std::string category, std::string key, std::string value)
+void settings_flush()
 {
-	nlohmann::json j_sub;
-	if (settings_json.contains(category))
-		j_sub = settings_json[category];
+	if (settings_dirty)
+		save_settings();
+}
 
-	j_sub[key] = value;
-	settings_json[category] = j_sub;
+void settings_mark_dirty()
+{
+	settings_dirty = true;
+}
+
+void settings_set_value(std::string category, std::string key, std::string value)
+{
 	print_debug("Set " + key + " to " + value);
-	save_settings();
+
+	if (const setting_entry* entry = find_setting(category, key))
+	{
+		setting_from_string(*entry, value);
+		settings_dirty = true;
+		return;
+	}
+
+	settings_json[category][key] = value;
+	settings_dirty = true;
 }
 
 std::string settings_get_value(std::string category, std::string key)
 {
-	if (settings_json.contains(category))
-	{
-		nlohmann::json j_sub = settings_json[category];
+	if (const setting_entry* entry = find_setting(category, key))
+		return setting_to_string(*entry);
 
-		if (j_sub.contains(key))
-		{
-			if (key != "debug")
-				printf(std::string("[BRICKGAME] Reading setting " + category + " " + key + "\n").c_str());
-			return (j_sub[key]);
-		}
+	auto j_sub = settings_json.find(category);
+	if (j_sub != settings_json.end())
+	{
+		auto value = j_sub->find(key);
+		if (value != j_sub->end())
+			return *value;
 		else
 		{
-			printf(std::string("[BRICKGAME] Heads up! Setting: " + category + ", >" + key + "< not found.\n").c_str());
+			LOG_WARN(log_io, "Heads up! Setting: %s, >%s< not found.", category.c_str(), key.c_str());
 			return "---";
 		}
 	}
 	else
 	{
-		printf(std::string("[BRICKGAME] Heads up! Setting: >" + category + "<, " + key + " not found.\n").c_str());
+		LOG_WARN(log_io, "Heads up! Setting: >%s<, %s not found.", category.c_str(), key.c_str());
 		return "---";
 	}
 }
@@ -72,24 +176,15 @@ bool settings_get_value_true(std::string category, std::string key)
 	return (settings_get_value(category, key) == "true");
 }
 
-void initialize_setting(std::string category, std::string setting, std::string initial)
-{
-	if (settings_get_value(category, setting) == "---")
-	{
-		settings_set_value(category, setting, initial);
-	}
-}
-
 void init_settings()
 {
-	settings_set_value("meta", "debug", "true");
+	settings_set(settings.debug, true);
 
-	if (settings_get_value("history", "last seen version") == "---" || (APP_VERSION != settings_get_value("history", "last seen version")))
+	if (settings.last_seen_version != APP_VERSION)
 	{
-		settings_set_value("history", "last seen version", APP_VERSION);
+		settings_set(settings.last_seen_version, std::string(APP_VERSION));
 		print_debug("DIFFERING VERSION!!");
 	}
 
-	initialize_setting("temp_prefs", "music_bool", "true");
-	initialize_setting("temp_prefs", "sound_bool", "true");
+	settings_flush();
 }
@@ -1,19 +1,26 @@
 #include <string>
 #include <settings.h>
-#include <nanovg.h>
+#include <cmath>
+#include <utils.hpp>
+#include <utils/log.h>
+
+#ifndef __SWITCH__
+#include <platform/pc/application_pc.h>
+#endif
 
 void print_debug(std::string str)
 {
-	if (settings_get_value_true("meta", "debug"))
-	{
-		str = "[BRICKGAME] " + str + "\n";
-		printf(str.c_str());
-	}
+	if (settings.debug)
+		LOG_DEBUG(log_core, "%s", str.c_str());
 }
 
 std::string get_config_path()
 {
+#ifdef __SWITCH__
 	return "sdmc:/config/brickgame/";
+#else
+	return config_path_pc();
+#endif
 }
 
 std::string get_settings_path()
@@ -22,6 +29,11 @@ std::string get_settings_path()
 }
 
 std::string get_scores_path()
+{
+	return get_config_path() + "scores.bin";
+}
+
+std::string get_scores_json_path()
 {
 	return get_config_path() + "scores.json";
 }
@@ -57,12 +69,12 @@ void create_directories(std::string path)
 
 double lengthdir_x(double length, double direction_degrees)
 {
-	return length * cos(nvgDegToRad(direction_degrees));
+	return length * cos(DegToRad(direction_degrees));
 }
 
 double lengthdir_y(double length, double direction_degrees)
 {
-	return length * -sin(nvgDegToRad(direction_degrees));
+	return length * -sin(DegToRad(direction_degrees));
 }
 
 #define PI 3.14159265358979323846264338327f
@@ -0,0 +1,154 @@
+#include <utils/log.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+std::atomic<unsigned int> log_enabled_modules{ log_all };
+std::atomic<int> log_runtime_level{ log_level_debug };
+
+// Bounded multi-producer ring (Vyukov). Each slot carries a sequence number: a
+// producer claims a slot by advancing write_position with a CAS, fills it, then
+// publishes it by bumping the sequence. Only the writer thread reads.
+static const unsigned int log_slot_count = 256;
+static const unsigned int log_message_length = 120;
+
+struct log_slot
+{
+	std::atomic<unsigned int> sequence;
+	log_level level;
+	char message[log_message_length];
+};
+
+class log_ring
+{
+public:
+	log_ring()
+	{
+		for (unsigned int i = 0; i < log_slot_count; i++)
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	log_slot slots[log_slot_count];
+	std::atomic<unsigned int> write_position{ 0 };
+	unsigned int read_position = 0;
+	std::atomic<unsigned long long> dropped{ 0 };
+
+	// Serialises readers, log_drain can be called while the thread runs
+	std::mutex read_mutex;
+	std::thread thread;
+	std::atomic<bool> running{ false };
+};
+
+static log_ring ring;
+
+static const char* level_prefix(log_level level)
+{
+	switch (level)
+	{
+	case log_level_warn: return "Warning: ";
+	case log_level_error: return "Error: ";
+	default: return "";
+	}
+}
+
+void log_write(log_level level, log_module module, const char* format, ...)
+{
+	unsigned int position = ring.write_position.load(std::memory_order_relaxed);
+	log_slot* slot;
+
+	while (true)
+	{
+		slot = &ring.slots[position % log_slot_count];
+		int difference = (int)(slot->sequence.load(std::memory_order_acquire) - position);
+
+		if (difference == 0)
+		{
+			if (ring.write_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (difference < 0)
+		{
+			// Full, the writer hasn't caught up
+			ring.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else
+			position = ring.write_position.load(std::memory_order_relaxed);
+	}
+
+	slot->level = level;
+	va_list args;
+	va_start(args, format);
+	vsnprintf(slot->message, sizeof(slot->message), format, args);
+	va_end(args);
+
+	slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+void log_drain()
+{
+	std::lock_guard<std::mutex> lock(ring.read_mutex);
+
+	bool printed = false;
+	while (true)
+	{
+		log_slot& slot = ring.slots[ring.read_position % log_slot_count];
+		if (slot.sequence.load(std::memory_order_acquire) != ring.read_position + 1)
+			break;
+
+		printf("[BRICKGAME] %s%s\n", level_prefix(slot.level), slot.message);
+		printed = true;
+
+		slot.sequence.store(ring.read_position + log_slot_count, std::memory_order_release);
+		ring.read_position += 1;
+	}
+
+	if (printed)
+		fflush(stdout);
+}
+
+static void log_writer_loop()
+{
+	while (ring.running.load(std::memory_order_relaxed))
+	{
+		log_drain();
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	log_drain();
+}
+
+void start_log_writer()
+{
+	if (ring.running.exchange(true))
+		return;
+	ring.thread = std::thread(log_writer_loop);
+}
+
+void stop_log_writer()
+{
+	if (!ring.running.exchange(false))
+		return;
+	ring.thread.join();
+
+	if (ring.dropped.load() > 0)
+		printf("[BRICKGAME] %llu log messages dropped\n", ring.dropped.load());
+}
+
+void log_set_level(log_level level)
+{
+	log_runtime_level.store(level, std::memory_order_relaxed);
+}
+
+void log_set_modules(unsigned int modules)
+{
+	log_enabled_modules.store(modules, std::memory_order_relaxed);
+}
+
+unsigned long long log_dropped_count()
+{
+	return ring.dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,132 @@
+#include <utils/safe_file.h>
+#include <utils.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+static const char* footer_prefix = "\n// crc32 ";
+static const size_t footer_length = strlen("\n// crc32 ") + 8 + 1;
+
+struct crc32_table
+{
+	unsigned int entries[256];
+};
+
+static constexpr crc32_table make_crc32_table()
+{
+	crc32_table table = {};
+	for (unsigned int i = 0; i < 256; i++)
+	{
+		unsigned int c = i;
+		for (int k = 0; k < 8; k++)
+			c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+		table.entries[i] = c;
+	}
+	return table;
+}
+
+// Built at compile time, so the score writer and the main thread can share it freely
+static constexpr crc32_table crc_table = make_crc32_table();
+
+unsigned int crc32(const std::string& data)
+{
+	unsigned int crc = 0xFFFFFFFFu;
+	for (unsigned char byte : data)
+		crc = crc_table.entries[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFFu;
+}
+
+bool safe_write_file(const std::string& path, const std::string& contents)
+{
+	std::string temp_path = path + ".tmp";
+	std::string backup_path = path + ".bak";
+
+	char footer[32];
+	snprintf(footer, sizeof(footer), "%s%08x\n", footer_prefix, crc32(contents));
+
+	FILE* file = fopen(temp_path.c_str(), "wb");
+	if (file == NULL)
+	{
+		print_debug("Could not open " + temp_path + " for writing");
+		return false;
+	}
+
+	bool written = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+	written = written && fputs(footer, file) >= 0;
+	written = written && fflush(file) == 0;
+	written = written && fsync(fileno(file)) == 0;
+	written = (fclose(file) == 0) && written;
+
+	if (!written)
+	{
+		print_debug("Could not write " + temp_path);
+		remove(temp_path.c_str());
+		return false;
+	}
+
+	// Never rename onto an existing file, not every filesystem replaces atomically.
+	// Between the two renames the last good copy is path.bak, which readers fall back to.
+	remove(backup_path.c_str());
+	if (access(path.c_str(), F_OK) == 0 && rename(path.c_str(), backup_path.c_str()) != 0)
+	{
+		print_debug("Could not back up " + path);
+		remove(temp_path.c_str());
+		return false;
+	}
+
+	if (rename(temp_path.c_str(), path.c_str()) != 0)
+	{
+		print_debug("Could not move " + temp_path + " into place");
+		return false;
+	}
+
+	return true;
+}
+
+bool safe_read_single_file(const std::string& path, std::string& contents)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	std::stringstream buffer;
+	buffer << file.rdbuf();
+	std::string data = buffer.str();
+
+	size_t footer_at = data.rfind(footer_prefix);
+	if (footer_at == std::string::npos || data.size() - footer_at != footer_length)
+	{
+		// Saved before checksums were added
+		contents = data;
+		return true;
+	}
+
+	unsigned int expected = (unsigned int)strtoul(data.c_str() + footer_at + strlen(footer_prefix), NULL, 16);
+	data.resize(footer_at);
+
+	if (crc32(data) != expected)
+	{
+		print_debug("Checksum mismatch in " + path);
+		return false;
+	}
+
+	contents = data;
+	return true;
+}
+
+bool safe_read_file(const std::string& path, std::string& contents)
+{
+	if (safe_read_single_file(path, contents))
+		return true;
+
+	if (safe_read_single_file(path + ".bak", contents))
+	{
+		print_debug("Using last good copy of " + path);
+		return true;
+	}
+
+	return false;
+}
@@ -1,66 +1,357 @@
-#include <utils/base64.h>
 #include <utils/scores.h>
+#include <utils/safe_file.h>
 #include <utils.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <nlohmann/json.hpp>
 
-nlohmann::json scores_json;
+struct score_file_header
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t record_size;
+	uint32_t record_count;
+};
+
+static const char score_file_magic[4] = { 'B', 'G', 'S', 'C' };
+static const uint32_t score_file_version = 1;
+
+// records is shared with the writer thread, everything touching it holds scores_mutex.
+// Setting a score only marks it dirty, the writer coalesces those into one file write.
+class score_writer
+{
+public:
+	std::mutex scores_mutex;
+	std::condition_variable wake;
+	std::thread thread;
+	bool running = false;
+	bool stopping = false;
+	bool dirty = false;
+	// Bumped on every change, so a save can tell whether it caught the latest one
+	unsigned int changes = 0;
+	bool flush_requested = false;
+	std::chrono::seconds flush_interval{ 10 };
+	std::vector<score_record> records;
+};
+
+static score_writer writer;
+
+static void mark_dirty()
+{
+	writer.dirty = true;
+	writer.changes += 1;
+}
+
+static bool valid_game_id(int game_id)
+{
+	return game_id >= 0 && game_id < (int)writer.records.size();
+}
+
+static int find_or_add_record(const std::string& name)
+{
+	for (unsigned int i = 0; i < writer.records.size(); i++)
+		if (name == writer.records[i].name)
+			return i;
+
+	score_record record = {};
+	strncpy(record.name, name.c_str(), sizeof(record.name) - 1);
+	writer.records.push_back(record);
+	return writer.records.size() - 1;
+}
+
+// Whole file in, one copy into the array. Anything that doesn't add up is rejected.
+static bool parse_score_file(const std::string& contents, std::vector<score_record>& records)
+{
+	score_file_header header;
+	if (contents.size() < sizeof(header))
+		return false;
+
+	memcpy(&header, contents.data(), sizeof(header));
+	if (memcmp(header.magic, score_file_magic, sizeof(header.magic)) != 0 || header.version != score_file_version
+		|| header.record_size != sizeof(score_record) || contents.size() != sizeof(header) + (size_t)header.record_count * sizeof(score_record))
+		return false;
+
+	records.resize(header.record_count);
+	memcpy(records.data(), contents.data() + sizeof(header), header.record_count * sizeof(score_record));
+	for (score_record& record : records)
+		record.name[sizeof(record.name) - 1] = '\0';
+	return true;
+}
 
 void read_scores()
 {
-	if (std::filesystem::exists(get_scores_path()))
+	std::string contents;
+	std::vector<score_record> records;
+	bool loaded = safe_read_file(get_scores_path(), contents) && parse_score_file(contents, records);
+	if (!loaded)
+		loaded = safe_read_single_file(get_scores_path() + ".bak", contents) && parse_score_file(contents, records);
+
+	{
+		std::lock_guard<std::mutex> lock(writer.scores_mutex);
+		writer.records = records;
+		writer.dirty = false;
+	}
+
+	// First run after the switch to scores.bin
+	if (!loaded && std::filesystem::exists(get_scores_json_path()))
 	{
-		std::ifstream i(get_scores_path());
-		scores_json.clear();
-		i >> scores_json;
+		print_debug("Importing " + get_scores_json_path());
+		scores_import_json(get_scores_json_path());
 	}
 }
 
 void save_scores()
 {
-	std::ofstream o(get_scores_path());
-	o << scores_json << std::endl;
-}
+	std::string contents;
+	unsigned int changes_saved;
+	{
+		std::lock_guard<std::mutex> lock(writer.scores_mutex);
 
-void scores_set_score_value(std::string category, std::string game, std::string value)
-{
-	//std::string category = "score";
+		score_file_header header;
+		memcpy(header.magic, score_file_magic, sizeof(header.magic));
+		header.version = score_file_version;
+		header.record_size = sizeof(score_record);
+		header.record_count = writer.records.size();
 
-	nlohmann::json j_sub;
-	if (scores_json.contains(category))
-		j_sub = scores_json[category];
+		contents.resize(sizeof(header) + writer.records.size() * sizeof(score_record));
+		memcpy(&contents[0], &header, sizeof(header));
+		memcpy(&contents[sizeof(header)], writer.records.data(), writer.records.size() * sizeof(score_record));
+		changes_saved = writer.changes;
+	}
 
-	j_sub[game] = value;
-	scores_json[category] = j_sub;
-	print_debug("Set " + game + " score to " + value);
+	// The file I/O happens outside the lock, the frame thread never waits on the SD card
+	create_directories(get_config_path());
+	bool written = safe_write_file(get_scores_path(), contents);
 
-	save_scores();
+	// A failed write, or a change made while writing, stays dirty for the next try
+	std::lock_guard<std::mutex> lock(writer.scores_mutex);
+	if (written && writer.changes == changes_saved)
+		writer.dirty = false;
 }
 
-std::string scores_get_score_value(std::string category, std::string key)
+static void score_writer_loop()
 {
-	//std::string category = "score";
-	if (scores_json.contains(category))
+	std::unique_lock<std::mutex> lock(writer.scores_mutex);
+
+	while (!writer.stopping)
 	{
-		nlohmann::json j_sub = scores_json[category];
+		writer.wake.wait_for(lock, writer.flush_interval, [] { return writer.stopping || writer.flush_requested; });
+		writer.flush_requested = false;
 
-		if (j_sub.contains(key))
+		if (writer.dirty)
 		{
-			if (key != "debug")
-				printf(std::string("[BRICKGAME] Reading score " + category + " " + key + "\n").c_str());
-			return (j_sub[key]);
+			lock.unlock();
+			save_scores();
+			lock.lock();
 		}
-		else
+	}
+}
+
+void start_score_writer(unsigned int flush_interval_seconds)
+{
+	std::lock_guard<std::mutex> lock(writer.scores_mutex);
+	if (writer.running)
+		return;
+
+	writer.flush_interval = std::chrono::seconds(flush_interval_seconds);
+	writer.stopping = false;
+	writer.running = true;
+	writer.thread = std::thread(score_writer_loop);
+}
+
+void stop_score_writer()
+{
+	{
+		std::lock_guard<std::mutex> lock(writer.scores_mutex);
+		if (!writer.running)
+			return;
+		writer.stopping = true;
+	}
+
+	writer.wake.notify_one();
+	writer.thread.join();
+	writer.running = false;
+
+	scores_flush();
+}
+
+void scores_request_flush()
+{
+	bool running;
+	{
+		std::lock_guard<std::mutex> lock(writer.scores_mutex);
+		running = writer.running;
+		writer.flush_requested = true;
+	}
+
+	if (running)
+		writer.wake.notify_one();
+	else
+		scores_flush();
+}
+
+void scores_flush()
+{
+	bool dirty;
+	{
+		std::lock_guard<std::mutex> lock(writer.scores_mutex);
+		dirty = writer.dirty;
+	}
+
+	if (dirty)
+		save_scores();
+}
+
+int scores_game_id(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(writer.scores_mutex);
+	return find_or_add_record(name);
+}
+
+void scores_set_score(int game_id, int64_t score)
+{
+	std::lock_guard<std::mutex> lock(writer.scores_mutex);
+	if (!valid_game_id(game_id))
+		return;
+
+	writer.records[game_id].score = score;
+	mark_dirty();
+}
+
+void scores_set_highscore(int game_id, int64_t highscore)
+{
+	std::lock_guard<std::mutex> lock(writer.scores_mutex);
+	if (!valid_game_id(game_id))
+		return;
+
+	writer.records[game_id].highscore = highscore;
+	writer.records[game_id].flags |= score_has_highscore;
+	mark_dirty();
+}
+
+bool scores_get_highscore(int game_id, int64_t& highscore)
+{
+	std::lock_guard<std::mutex> lock(writer.scores_mutex);
+	if (!valid_game_id(game_id) || !(writer.records[game_id].flags & score_has_highscore))
+		return false;
+
+	highscore = writer.records[game_id].highscore;
+	return true;
+}
+
+void scores_record_play(int game_id)
+{
+	int64_t now = time(NULL);
+
+	std::lock_guard<std::mutex> lock(writer.scores_mutex);
+	if (!valid_game_id(game_id))
+		return;
+
+	score_record& record = writer.records[game_id];
+	record.play_count += 1;
+	if (record.first_played == 0)
+		record.first_played = now;
+	record.last_played = now;
+	mark_dirty();
+}
+
+score_record scores_get_record(int game_id)
+{
+	std::lock_guard<std::mutex> lock(writer.scores_mutex);
+	if (!valid_game_id(game_id))
+		return score_record{};
+
+	return writer.records[game_id];
+}
+
+static bool json_number(const nlohmann::json& value, int64_t& number)
+{
+	if (value.is_number_integer())
+	{
+		number = value.get<int64_t>();
+		return true;
+	}
+	if (value.is_number())
+	{
+		number = (int64_t)value.get<double>();
+		return true;
+	}
+	if (value.is_string())
+	{
+		// Old saves went through std::to_string, doubles come out as "12.000000"
+		const std::string& text = value.get_ref<const std::string&>();
+		char* end = NULL;
+		double parsed = strtod(text.c_str(), &end);
+		if (end == text.c_str())
+			return false;
+		number = (int64_t)parsed;
+		return true;
+	}
+	return false;
+}
+
+bool scores_import_json(const std::string& path)
+{
+	std::string contents;
+	if (!safe_read_file(path, contents))
+		return false;
+
+	nlohmann::json scores_json = nlohmann::json::parse(contents, nullptr, false);
+	if (scores_json.is_discarded() || !scores_json.is_object())
+		return false;
+
+	std::lock_guard<std::mutex> lock(writer.scores_mutex);
+	for (auto& game : scores_json.items())
+	{
+		if (!game.value().is_object())
+			continue;
+
+		score_record& record = writer.records[find_or_add_record(game.key())];
+		int64_t number;
+
+		if (game.value().contains("score") && json_number(game.value()["score"], number))
+			record.score = number;
+		if (game.value().contains("highscore") && json_number(game.value()["highscore"], number))
 		{
-			printf(std::string("[BRICKGAME] Heads up! Score: " + category + ", >" + key + "< not found.\n").c_str());
-			return "---";
+			record.highscore = number;
+			record.flags |= score_has_highscore;
 		}
+		if (game.value().contains("play_count") && json_number(game.value()["play_count"], number))
+			record.play_count = number;
+		if (game.value().contains("first_played") && json_number(game.value()["first_played"], number))
+			record.first_played = number;
+		if (game.value().contains("last_played") && json_number(game.value()["last_played"], number))
+			record.last_played = number;
 	}
-	else
+	mark_dirty();
+	return true;
+}
+
+bool scores_export_json(const std::string& path)
+{
+	nlohmann::json scores_json = nlohmann::json::object();
 	{
-		printf(std::string("[BRICKGAME] Heads up! Score: >" + category + "<, " + key + " not found.\n").c_str());
-		return "---";
+		std::lock_guard<std::mutex> lock(writer.scores_mutex);
+		for (const score_record& record : writer.records)
+		{
+			nlohmann::json& game = scores_json[record.name];
+			game["score"] = std::to_string(record.score);
+			if (record.flags & score_has_highscore)
+				game["highscore"] = std::to_string(record.highscore);
+			game["play_count"] = record.play_count;
+			game["first_played"] = record.first_played;
+			game["last_played"] = record.last_played;
+		}
 	}
-}
\ No newline at end of file
+
+	create_directories(get_config_path());
+	return safe_write_file(path, scores_json.dump());
+}
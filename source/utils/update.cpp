@@ -173,7 +173,7 @@ bool check_for_updates()
         }
     }
 
-    if (settings_get_value_true("meta", "debug"))
+    if (settings.debug)
     {
         print_debug("debug force up\n");
         set_online_version_available(true);
@@ -0,0 +1,97 @@
+#include <game.h>
+#include <utils/settings.h>
+#include <platform/audio_layer.h>
+#include <platform/pc/control_layer_pc.h>
+#include "tests.hpp"
+
+// One framework for the whole run, game_list and the object list are global
+BrickGameFramework& test_framework()
+{
+	static bool initialized = false;
+	if (!initialized)
+	{
+		init_settings();
+		init_audio();
+		initialized = true;
+	}
+
+	static BrickGameFramework app;
+	return app;
+}
+
+// Mashes every direction and button on a fixed pattern
+static unsigned int scripted_input(unsigned int frame)
+{
+	unsigned int buttons = 0;
+	if (frame % 5 == 0)
+		buttons |= pc_button_left;
+	if (frame % 7 == 0)
+		buttons |= pc_button_right;
+	if (frame % 11 == 0)
+		buttons |= pc_button_up;
+	if (frame % 13 == 0)
+		buttons |= pc_button_down;
+	if (frame % 17 == 0)
+		buttons |= pc_button_A;
+	return buttons;
+}
+
+TEST(every_game_runs_headless)
+{
+	BrickGameFramework& app = test_framework();
+	set_input_script_pc(scripted_input);
+
+	for (unsigned int i = 0; i < game_list.size(); i++)
+	{
+		app.SwitchToGame(i);
+		app.run_frames(1500);
+
+		CHECK(grid_width(app.game_grid) > 0);
+		CHECK(grid_height(app.game_grid) > 0);
+	}
+
+	app.SwitchToGame(0);
+	app.run_frames(400);
+}
+
+TEST(frames_run_ticks_for_elapsed_time)
+{
+	BrickGameFramework& app = test_framework();
+	set_input_script_pc([](unsigned int) { return 0u; });
+	app.set_tick_rate(60);
+
+	const u64 tick = 1000000000ULL / 60;
+	u64 now = 1000000000000000ULL;
+	app.onFrame(now);
+
+	// 30 Hz frames run two ticks each
+	unsigned int ticks_before = app.game_time_in_frames;
+	now += tick * 2;
+	app.onFrame(now);
+	CHECK_EQ(app.game_time_in_frames - ticks_before, 2u);
+
+	// Half a tick runs nothing and draws halfway
+	ticks_before = app.game_time_in_frames;
+	now += tick / 2;
+	app.onFrame(now);
+	CHECK_EQ(app.game_time_in_frames - ticks_before, 0u);
+	CHECK(app.tick_interpolation > 0.45f && app.tick_interpolation < 0.55f);
+
+	// A long stall is capped
+	ticks_before = app.game_time_in_frames;
+	now += tick * 100;
+	app.onFrame(now);
+	CHECK_EQ(app.game_time_in_frames - ticks_before, app.max_ticks_per_frame);
+
+	// Time scale multiplies ticks per frame
+	app.time_scale = 16;
+	ticks_before = app.game_time_in_frames;
+	now += tick;
+	app.onFrame(now);
+	CHECK_EQ(app.game_time_in_frames - ticks_before, 16u);
+	app.time_scale = 1;
+
+	ticks_before = app.game_time_in_frames;
+	CHECK(app.simulate_ticks(500));
+	CHECK_EQ(app.game_time_in_frames - ticks_before, 500u);
+}
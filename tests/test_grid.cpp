@@ -0,0 +1,113 @@
+#include <grid.hpp>
+#include "tests.hpp"
+
+TEST(grid_create_clamps_size)
+{
+	Grid grid = grid_create(100, -3);
+	CHECK_EQ(grid_width(grid), Grid::max_width);
+	CHECK_EQ(grid_height(grid), 0);
+}
+
+TEST(grid_set_and_get)
+{
+	Grid grid = grid_create(10, 20);
+	CHECK(grid_set(grid, 3, 7, true));
+	CHECK(grid_get(grid, 3, 7));
+	CHECK(!grid_get(grid, 7, 3));
+	CHECK(grid_get_unchecked(grid, 3, 7));
+
+	CHECK(grid_set(grid, 3, 7, false));
+	CHECK(!grid_get(grid, 3, 7));
+}
+
+TEST(grid_out_of_bounds_is_ignored)
+{
+	Grid grid = grid_create(10, 20);
+	CHECK(!grid_set(grid, -1, 0, true));
+	CHECK(!grid_set(grid, 10, 0, true));
+	CHECK(!grid_set(grid, 0, 20, true));
+	CHECK(!grid_get(grid, -1, 0));
+	CHECK(!grid_get(grid, 0, 20));
+}
+
+TEST(grid_additive_set_never_clears)
+{
+	Grid grid = grid_create(4, 4);
+	grid_set(grid, 1, 1, true);
+	CHECK(!grid_set(grid, 1, 1, false, true));
+	CHECK(grid_get(grid, 1, 1));
+}
+
+TEST(grid_literal_is_written_as_on_screen)
+{
+	Grid sprite = {
+		{ 0, 1, 0 },
+		{ 1, 1, 1 }
+	};
+	CHECK_EQ(grid_width(sprite), 3);
+	CHECK_EQ(grid_height(sprite), 2);
+	CHECK(grid_get(sprite, 1, 0));
+	CHECK(!grid_get(sprite, 0, 0));
+	CHECK(grid_get(sprite, 0, 1));
+	CHECK(grid_get(sprite, 2, 1));
+}
+
+TEST(grid_clear_empties_every_row)
+{
+	Grid grid = grid_create(10, 40);
+	grid_set(grid, 0, 0, true);
+	grid_set(grid, 9, 39, true);
+	grid_clear(grid);
+	CHECK(!grid_get(grid, 0, 0));
+	CHECK(!grid_get(grid, 9, 39));
+}
+
+TEST(grid_tall_grids_copy_their_rows)
+{
+	Grid grid = grid_create(8, 50);
+	grid_set(grid, 5, 45, true);
+	Grid copy = grid;
+	grid_set(grid, 5, 45, false);
+	CHECK(grid_get(copy, 5, 45));
+	CHECK(!grid_get(grid, 5, 45));
+}
+
+TEST(emplace_grid_clips_at_every_edge)
+{
+	Grid sprite = {
+		{ 1, 1 },
+		{ 1, 1 }
+	};
+
+	Grid grid = grid_create(4, 4);
+	emplace_grid_in_grid(grid, sprite, -1, -1, true);
+	CHECK(grid_get(grid, 0, 0));
+	CHECK(!grid_get(grid, 1, 0));
+	CHECK(!grid_get(grid, 0, 1));
+
+	emplace_grid_in_grid(grid, sprite, 3, 3, true);
+	CHECK(grid_get(grid, 3, 3));
+	CHECK(!grid_get(grid, 2, 3));
+
+	emplace_grid_in_grid(grid, sprite, 10, 0, true);
+	emplace_grid_in_grid(grid, sprite, -2, 0, true);
+	CHECK(!grid_get(grid, 1, 1));
+}
+
+TEST(emplace_grid_replaces_unless_additive)
+{
+	Grid sprite = {
+		{ 1, 0 }
+	};
+
+	Grid grid = grid_create(4, 1);
+	grid_set(grid, 2, 0, true);
+
+	emplace_grid_in_grid(grid, sprite, 1, 0, true);
+	CHECK(grid_get(grid, 1, 0));
+	CHECK(grid_get(grid, 2, 0));
+
+	emplace_grid_in_grid(grid, sprite, 1, 0, false);
+	CHECK(grid_get(grid, 1, 0));
+	CHECK(!grid_get(grid, 2, 0));
+}
@@ -0,0 +1,62 @@
+#include <grid.hpp>
+#include <grid_rows.hpp>
+#include "tests.hpp"
+
+static Grid make_board(std::initializer_list<int> full_rows, int width = 10, int height = 20)
+{
+	Grid grid = grid_create(width, height);
+	for (int row : full_rows)
+		fill_row(grid, row, true);
+	return grid;
+}
+
+TEST(row_full_mask_finds_full_rows_only)
+{
+	Grid grid = make_board({ 3, 19 });
+	grid_set(grid, 0, 5, true);
+	CHECK_EQ(row_full_mask(grid), ((uint64_t)1 << 3) | ((uint64_t)1 << 19));
+}
+
+TEST(collapse_rows_drops_rows_above)
+{
+	Grid grid = make_board({ 18, 19 });
+	grid_set(grid, 4, 10, true);
+
+	CHECK_EQ(collapse_rows(grid, row_full_mask(grid)), 2);
+	CHECK_EQ(row_full_mask(grid), (uint64_t)0);
+	CHECK(grid_get(grid, 4, 12));
+	CHECK(!grid_get(grid, 4, 10));
+}
+
+TEST(collapse_rows_toward_top_lifts_rows_below)
+{
+	Grid grid = make_board({ 0, 1 });
+	grid_set(grid, 2, 5, true);
+
+	CHECK_EQ(collapse_rows(grid, row_full_mask(grid), true), 2);
+	CHECK(grid_get(grid, 2, 3));
+	CHECK(!grid_get(grid, 2, 5));
+}
+
+TEST(shift_down_from_removes_one_row)
+{
+	Grid grid = grid_create(10, 20);
+	grid_set(grid, 1, 0, true);
+	grid_set(grid, 2, 7, true);
+	grid_set(grid, 3, 8, true);
+
+	shift_down_from(grid, 8);
+	CHECK(grid_get(grid, 1, 1));
+	CHECK(grid_get(grid, 2, 8));
+	CHECK(!grid_get(grid, 3, 8));
+	CHECK(!grid_get(grid, 1, 0));
+}
+
+TEST(lowest_occupied_row_of_empty_grid)
+{
+	Grid grid = grid_create(10, 20);
+	CHECK_EQ(lowest_occupied_row(grid), -1);
+	grid_set(grid, 0, 4, true);
+	grid_set(grid, 9, 12, true);
+	CHECK_EQ(lowest_occupied_row(grid), 12);
+}
@@ -0,0 +1,46 @@
+#include <utils/log.h>
+#include "tests.hpp"
+
+static int evaluated = 0;
+
+static int count_evaluation()
+{
+	evaluated += 1;
+	return evaluated;
+}
+
+TEST(log_sites_below_min_level_compile_out)
+{
+	evaluated = 0;
+	LOG_TRACE(log_core, "%i", count_evaluation());
+	CHECK_EQ(evaluated, 0);
+}
+
+TEST(log_disabled_module_skips_formatting)
+{
+	evaluated = 0;
+	log_set_modules(log_all & ~log_games);
+	LOG_DEBUG(log_games, "%i", count_evaluation());
+	CHECK_EQ(evaluated, 0);
+
+	log_set_modules(log_all);
+	LOG_DEBUG(log_games, "%i", count_evaluation());
+	CHECK_EQ(evaluated, 1);
+	log_drain();
+}
+
+TEST(log_full_ring_drops_instead_of_blocking)
+{
+	log_drain();
+	unsigned long long dropped = log_dropped_count();
+
+	for (int i = 0; i < 300; i++)
+		log_write(log_level_debug, log_core, "flood %i", i);
+
+	CHECK_EQ(log_dropped_count() - dropped, 300ULL - 256ULL);
+	log_drain();
+
+	log_write(log_level_debug, log_core, "after drain");
+	CHECK_EQ(log_dropped_count() - dropped, 300ULL - 256ULL);
+	log_drain();
+}
@@ -0,0 +1,72 @@
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <platform/pc/application_pc.h>
+#include "tests.hpp"
+
+struct test_case
+{
+	const char* name;
+	test_function function;
+};
+
+static std::vector<test_case>& test_registry()
+{
+	static std::vector<test_case> registry;
+	return registry;
+}
+
+static int current_failures = 0;
+
+test_registrar::test_registrar(const char* name, test_function function)
+{
+	test_registry().push_back({ name, function });
+}
+
+void test_failed(const char* file, int line, const char* expression)
+{
+	printf("  %s:%i: CHECK failed: %s\n", file, line, expression);
+	current_failures += 1;
+}
+
+// brickgame_tests [filter], runs every test whose name contains filter
+int main(int argc, char* argv[])
+{
+	const char* filter = (argc > 1) ? argv[1] : "";
+	int run = 0;
+	int failed = 0;
+
+	// Settings and scores go to a fresh folder, never one left over from another run
+	std::string config_path = (std::filesystem::temp_directory_path() / "brickgame_tests_XXXXXX").string();
+	if (mkdtemp(&config_path[0]) == NULL)
+	{
+		printf("Couldn't make a config folder in %s\n", config_path.c_str());
+		return 1;
+	}
+	set_config_path_pc(config_path);
+
+	for (const test_case& test : test_registry())
+	{
+		if (strstr(test.name, filter) == NULL)
+			continue;
+
+		current_failures = 0;
+		test.function();
+		run += 1;
+
+		if (current_failures > 0)
+		{
+			failed += 1;
+			printf("FAIL %s\n", test.name);
+		}
+		else
+			printf("ok   %s\n", test.name);
+	}
+
+	std::filesystem::remove_all(config_path);
+
+	printf("%i tests, %i failed\n", run, failed);
+	return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+#include <game.h>
+#include <object_manager.h>
+#include "tests.hpp"
+
+class obj_test_a : public game_object
+{
+public:
+	obj_test_a(BrickGameFramework& game, int _x, int _y) : game_object(game, _x, _y) {}
+	void step_function() override {}
+	void draw_function() override {}
+	void destroy_function() override {}
+};
+
+class obj_test_b : public obj_test_a
+{
+public:
+	using obj_test_a::obj_test_a;
+};
+
+TEST(instance_find_matches_exact_type)
+{
+	BrickGameFramework& game = test_framework();
+	instance_destroy_all();
+
+	CHECK(instance_find<obj_test_a>() == NULL);
+	CHECK(!instance_exists<obj_test_b>());
+
+	obj_test_a* first = instance_create<obj_test_a>(game, 1, 0);
+	instance_create<obj_test_b>(game, 2, 0);
+	instance_create<obj_test_a>(game, 3, 0);
+
+	CHECK(instance_find<obj_test_a>() == first);
+	CHECK_EQ(instance_find<obj_test_b>()->x, 2.0);
+
+	instance_destroy_all();
+	CHECK(!instance_exists<obj_test_a>());
+}
+
+TEST(instance_for_each_visits_only_its_type)
+{
+	BrickGameFramework& game = test_framework();
+	instance_destroy_all();
+
+	instance_create<obj_test_a>(game, 1, 0);
+	instance_create<obj_test_b>(game, 10, 0);
+	instance_create<obj_test_a>(game, 2, 0);
+
+	double total = 0;
+	int visited = 0;
+	instance_for_each<obj_test_a>([&](obj_test_a& instance) { total += instance.x; visited++; });
+	CHECK_EQ(visited, 2);
+	CHECK_EQ(total, 3.0);
+
+	instance_destroy_all();
+}
+
+TEST(instance_destroy_unregisters_on_apply)
+{
+	BrickGameFramework& game = test_framework();
+	instance_destroy_all();
+
+	obj_test_a* first = instance_create<obj_test_a>(game, 1, 0);
+	obj_test_a* second = instance_create<obj_test_a>(game, 2, 0);
+
+	first->instance_destroy();
+	apply_object_updates();
+
+	CHECK(instance_find<obj_test_a>() == second);
+	CHECK_EQ(objects.size(), (size_t)1);
+
+	second->instance_destroy();
+	apply_object_updates();
+	CHECK(!instance_exists<obj_test_a>());
+	CHECK(objects.empty());
+}
+
+TEST(instance_pool_reuses_freed_slots)
+{
+	BrickGameFramework& game = test_framework();
+	instance_destroy_all();
+
+	obj_test_a* first = instance_create<obj_test_a>(game, 1, 0);
+	first->instance_destroy();
+	apply_object_updates();
+
+	obj_test_a* second = instance_create<obj_test_a>(game, 2, 0);
+	CHECK(second == first);
+	CHECK_EQ(second->x, 2.0);
+
+	instance_destroy_all();
+}
+
+TEST(instance_destroy_swaps_last_into_gap)
+{
+	BrickGameFramework& game = test_framework();
+	instance_destroy_all();
+
+	obj_test_a* first = instance_create<obj_test_a>(game, 1, 0);
+	instance_create<obj_test_a>(game, 2, 0);
+	obj_test_a* third = instance_create<obj_test_a>(game, 3, 0);
+
+	first->instance_destroy();
+	apply_object_updates();
+
+	CHECK_EQ(objects.size(), (size_t)2);
+	CHECK(objects[0] == third);
+	CHECK_EQ(third->object_slot, 0u);
+	CHECK_EQ(third->type_slot, 0u);
+
+	instance_destroy_all();
+}
+
+TEST(object_updates_queue_until_applied)
+{
+	BrickGameFramework& game = test_framework();
+	instance_destroy_all();
+
+	obj_test_a* existing = instance_create<obj_test_a>(game, 1, 0);
+
+	begin_object_updates();
+	obj_test_b* spawned = instance_create<obj_test_b>(game, 2, 0);
+	existing->instance_destroy();
+
+	CHECK_EQ(objects.size(), (size_t)1);
+	CHECK(!instance_exists<obj_test_b>());
+	CHECK(instance_find<obj_test_a>() == existing);
+
+	apply_object_updates();
+
+	CHECK_EQ(objects.size(), (size_t)1);
+	CHECK(instance_find<obj_test_b>() == spawned);
+	CHECK(!instance_exists<obj_test_a>());
+
+	instance_destroy_all();
+}
+
+TEST(explosion_animates_per_tick_after_a_loss)
+{
+	BrickGameFramework& game = test_framework();
+	instance_destroy_all();
+
+	obj_explosion* explosion = instance_create<obj_explosion>(game, 5, 5);
+	game.running = false;
+
+	game.step_frame();
+	game.step_frame();
+	CHECK_EQ(explosion->animation_percent, 4.0);
+
+	// Drawing only reads it
+	game.draw_frame();
+	game.draw_frame();
+	CHECK_EQ(explosion->animation_percent, 4.0);
+
+	game.running = true;
+	instance_destroy_all();
+}
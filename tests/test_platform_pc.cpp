@@ -0,0 +1,80 @@
+#include <grid.hpp>
+#include <platform/control_layer.h>
+#include <platform/graphics_layer.h>
+#include <platform/pc/control_layer_pc.h>
+#include <platform/pc/graphics_layer_pc.h>
+#include "tests.hpp"
+
+TEST(pc_input_script_drives_held_and_pressed)
+{
+	init_controllers();
+	set_input_script_pc([](unsigned int frame) { return (frame >= 1) ? (unsigned int)pc_button_A : 0u; });
+
+	update_controller();
+	CHECK(!keyboard_check_A());
+
+	update_controller();
+	CHECK(keyboard_check_A());
+	CHECK(keyboard_check_pressed_A());
+
+	update_controller();
+	CHECK(keyboard_check_A());
+	CHECK(!keyboard_check_pressed_A());
+
+	set_held_buttons_pc(0);
+	update_controller();
+	CHECK(!keyboard_check_A());
+}
+
+TEST(pc_graphics_records_a_frame)
+{
+	initialize_graphics(1280, 720);
+	SpriteId on = load_sprite("test_on", "test_on.png");
+	SpriteId off = load_sprite("test_off", "test_off.png");
+	FontId font = load_font("test_font", "test_font.ttf");
+	CHECK(on.valid());
+	CHECK(off.valid());
+	CHECK(font.valid());
+
+	Grid grid = grid_create(10, 20);
+	grid_set(grid, 1, 1, true);
+	grid_set(grid, 2, 1, true);
+
+	gfx_set_reuse_unchanged_frames(false);
+	gfx_start_frame();
+	set_font(font);
+	draw_text(4, 8, "Score");
+	draw_cell_grid(0, 0, 31, 31, grid, on, off);
+	gfx_end_frame();
+
+	const std::vector<gfx_command_pc>& commands = gfx_frame_commands_pc();
+	CHECK_EQ(commands.size(), (size_t)3);
+	CHECK_EQ(commands.at(0).type, gfx_command_font);
+	CHECK_EQ(commands.at(0).handle, font.index);
+	CHECK_EQ(commands.at(1).type, gfx_command_text);
+	CHECK(std::string(gfx_command_text_pc(commands.at(1))) == "Score");
+	CHECK_EQ(commands.at(2).type, gfx_command_cell_grid);
+	CHECK_EQ(commands.at(2).count, 2);
+}
+
+TEST(pc_graphics_skips_unchanged_frames)
+{
+	initialize_graphics(1280, 720);
+	gfx_set_reuse_unchanged_frames(true);
+
+	unsigned int redrawn = gfx_frames_redrawn_pc();
+	for (int i = 0; i < 5; i++)
+	{
+		gfx_start_frame();
+		draw_rect(0, 0, 10, 10, 0, 0, 0, 255);
+		gfx_end_frame();
+	}
+
+	// The first frame differs from whatever came before, the rest match it
+	CHECK_EQ(gfx_frames_redrawn_pc() - redrawn, 1u);
+
+	gfx_start_frame();
+	draw_rect(0, 0, 20, 10, 0, 0, 0, 255);
+	gfx_end_frame();
+	CHECK_EQ(gfx_frames_redrawn_pc() - redrawn, 2u);
+}
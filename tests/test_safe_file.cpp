@@ -0,0 +1,94 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utils/safe_file.h>
+#include "tests.hpp"
+
+static const std::string test_path = "safe_file_test.json";
+
+static void remove_test_files()
+{
+	remove(test_path.c_str());
+	remove((test_path + ".bak").c_str());
+	remove((test_path + ".tmp").c_str());
+}
+
+static void overwrite(const std::string& path, const std::string& contents)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file << contents;
+}
+
+TEST(safe_file_round_trip)
+{
+	remove_test_files();
+	CHECK(safe_write_file(test_path, "{\"a\":1}"));
+
+	std::string contents;
+	CHECK(safe_read_file(test_path, contents));
+	CHECK_EQ(contents, std::string("{\"a\":1}"));
+	remove_test_files();
+}
+
+TEST(safe_file_keeps_previous_copy)
+{
+	remove_test_files();
+	CHECK(safe_write_file(test_path, "first"));
+	CHECK(safe_write_file(test_path, "second"));
+
+	std::string contents;
+	CHECK(safe_read_single_file(test_path + ".bak", contents));
+	CHECK_EQ(contents, std::string("first"));
+	remove_test_files();
+}
+
+TEST(safe_file_corrupt_falls_back_to_backup)
+{
+	remove_test_files();
+	CHECK(safe_write_file(test_path, "first"));
+	CHECK(safe_write_file(test_path, "second"));
+
+	// Flip a byte but leave the footer alone
+	std::ifstream in(test_path, std::ios::binary);
+	std::string raw((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	raw[0] = 'S';
+	overwrite(test_path, raw);
+
+	std::string contents;
+	CHECK(safe_read_file(test_path, contents));
+	CHECK_EQ(contents, std::string("first"));
+	remove_test_files();
+}
+
+TEST(safe_file_missing_falls_back_to_backup)
+{
+	remove_test_files();
+	CHECK(safe_write_file(test_path, "first"));
+	CHECK(safe_write_file(test_path, "second"));
+	// Crash between the two renames
+	remove(test_path.c_str());
+
+	std::string contents;
+	CHECK(safe_read_file(test_path, contents));
+	CHECK_EQ(contents, std::string("first"));
+	remove_test_files();
+}
+
+TEST(safe_file_accepts_files_without_footer)
+{
+	remove_test_files();
+	overwrite(test_path, "{\"legacy\":true}\n");
+
+	std::string contents;
+	CHECK(safe_read_file(test_path, contents));
+	CHECK_EQ(contents, std::string("{\"legacy\":true}\n"));
+	remove_test_files();
+}
+
+TEST(crc32_check_value)
+{
+	// The standard CRC-32 check value
+	CHECK_EQ(crc32("123456789"), 0xCBF43926u);
+	CHECK_EQ(crc32(""), 0u);
+}
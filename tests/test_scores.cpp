@@ -0,0 +1,102 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utils.hpp>
+#include <utils/scores.h>
+#include "tests.hpp"
+
+TEST(scores_game_id_is_stable)
+{
+	int id = scores_game_id("test_stable");
+	CHECK_EQ(scores_game_id("test_stable"), id);
+	CHECK(scores_game_id("test_other") != id);
+}
+
+TEST(scores_binary_round_trip)
+{
+	int id = scores_game_id("test_round_trip");
+	scores_set_score(id, 12);
+	scores_set_highscore(id, 5000000000LL);
+	scores_record_play(id);
+
+	save_scores();
+	scores_set_score(id, 99);
+	read_scores();
+
+	score_record record = scores_get_record(scores_game_id("test_round_trip"));
+	CHECK_EQ(record.score, (int64_t)12);
+	CHECK_EQ(record.highscore, (int64_t)5000000000LL);
+	CHECK_EQ(record.play_count, (int64_t)1);
+	CHECK(record.last_played != 0);
+}
+
+TEST(scores_highscore_unset_until_set)
+{
+	int id = scores_game_id("test_no_highscore");
+	int64_t highscore = -1;
+	CHECK(!scores_get_highscore(id, highscore));
+
+	scores_set_highscore(id, 0);
+	CHECK(scores_get_highscore(id, highscore));
+	CHECK_EQ(highscore, (int64_t)0);
+}
+
+TEST(scores_import_legacy_json)
+{
+	const std::string path = "scores_import_test.json";
+	{
+		std::ofstream file(path);
+		file << "{\"test_legacy\":{\"highscore\":\"40\",\"score\":\"12.000000\"},\"test_legacy_menu\":{\"score\":\"-3\"}}\n";
+	}
+
+	CHECK(scores_import_json(path));
+	remove(path.c_str());
+
+	int64_t highscore;
+	CHECK(scores_get_highscore(scores_game_id("test_legacy"), highscore));
+	CHECK_EQ(highscore, (int64_t)40);
+	CHECK_EQ(scores_get_record(scores_game_id("test_legacy")).score, (int64_t)12);
+	CHECK_EQ(scores_get_record(scores_game_id("test_legacy_menu")).score, (int64_t)-3);
+	CHECK(!scores_get_highscore(scores_game_id("test_legacy_menu"), highscore));
+}
+
+TEST(scores_export_then_import)
+{
+	const std::string path = "scores_export_test.json";
+	int id = scores_game_id("test_export");
+	scores_set_score(id, 7);
+	scores_set_highscore(id, 21);
+
+	CHECK(scores_export_json(path));
+	scores_set_score(id, 0);
+	scores_set_highscore(id, 1);
+
+	CHECK(scores_import_json(path));
+	remove(path.c_str());
+	remove((path + ".bak").c_str());
+
+	int64_t highscore;
+	CHECK(scores_get_highscore(id, highscore));
+	CHECK_EQ(highscore, (int64_t)21);
+	CHECK_EQ(scores_get_record(id).score, (int64_t)7);
+}
+
+TEST(scores_failed_save_is_retried)
+{
+	int id = scores_game_id("test_failed_save");
+	scores_set_score(id, 3);
+	save_scores();
+
+	// A folder where the tmp file goes makes the write fail
+	std::string blocker = get_scores_path() + ".tmp";
+	std::filesystem::create_directories(blocker);
+	scores_set_score(id, 7);
+	save_scores();
+	std::filesystem::remove(blocker);
+
+	scores_flush();
+	scores_set_score(id, 0);
+	read_scores();
+	CHECK_EQ(scores_get_record(scores_game_id("test_failed_save")).score, (int64_t)7);
+}
@@ -0,0 +1,61 @@
+#include <filesystem>
+#include <string>
+#include <utils.hpp>
+#include <utils/settings.h>
+#include "tests.hpp"
+
+TEST(settings_untyped_access_goes_through_cache)
+{
+	bool music = settings.music;
+
+	settings_set_value("temp_prefs", "music_bool", "false");
+	CHECK(!settings.music);
+	CHECK_EQ(settings_get_value("temp_prefs", "music_bool"), std::string("false"));
+
+	settings_set(settings.music, true);
+	CHECK(settings_get_value_true("temp_prefs", "music_bool"));
+
+	settings_set(settings.music, music);
+}
+
+TEST(settings_round_trip_through_file)
+{
+	bool sound = settings.sound;
+
+	settings_set(settings.sound, false);
+	settings_set_value("test", "unregistered", "kept");
+	settings_flush();
+
+	settings.sound = true;
+	settings_json = nlohmann::json::object();
+	read_settings();
+
+	CHECK(!settings.sound);
+	CHECK_EQ(settings_get_value("test", "unregistered"), std::string("kept"));
+
+	settings_set(settings.sound, sound);
+	settings_flush();
+}
+
+TEST(settings_failed_save_is_retried)
+{
+	bool sound = settings.sound;
+	settings_set(settings.sound, true);
+	settings_flush();
+
+	// A folder where the tmp file goes makes the write fail
+	std::string blocker = get_settings_path() + ".tmp";
+	std::filesystem::create_directories(blocker);
+	settings_set(settings.sound, false);
+	settings_flush();
+	std::filesystem::remove(blocker);
+
+	settings_flush();
+	settings.sound = true;
+	settings_json = nlohmann::json::object();
+	read_settings();
+	CHECK(!settings.sound);
+
+	settings_set(settings.sound, sound);
+	settings_flush();
+}
@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <game.h>
+#include <grid.hpp>
+#include <grid_rows.hpp>
+#include <games/game_tetris.h>
+#include <platform/pc/control_layer_pc.h>
+#include "tests.hpp"
+
+static_assert(tetromino_table[0][0].mask == 0x00F0, "I spawns on its second row");
+static_assert(tetromino_table[0][1].left == 2 && tetromino_table[0][1].right == 2, "vertical I sits in column 2");
+static_assert(tetromino_table[3][0].top == 0 && tetromino_table[3][0].bottom == 1, "O is two rows tall");
+static_assert(tetromino_kicks(0, 0, true)[1].x == -2, "I kicks from spawn, clockwise");
+static_assert(tetromino_kicks(1, 1, false)[2].y == -1, "JLSTZ kicks from R, counter-clockwise");
+
+TEST(tetromino_rotation_wraps)
+{
+	CHECK(&tetromino_shape(2, -1) == &tetromino_table[2][3]);
+	CHECK(&tetromino_shape(2, 4) == &tetromino_table[2][0]);
+}
+
+TEST(place_tetromino_matches_cells)
+{
+	// T pointing up: .#. / ###
+	Grid grid = grid_create(10, 20);
+	place_tetromino(grid, tetromino_shape(5, 0), 3, 5);
+
+	CHECK(grid_get(grid, 4, 5));
+	CHECK(grid_get(grid, 3, 6));
+	CHECK(grid_get(grid, 4, 6));
+	CHECK(grid_get(grid, 5, 6));
+	CHECK(!grid_get(grid, 3, 5));
+	CHECK(!grid_get(grid, 5, 5));
+}
+
+TEST(place_tetromino_clips_to_grid)
+{
+	// Vertical I in column 2 of its box, shifted so only its bottom cell lands
+	Grid grid = grid_create(10, 20);
+	place_tetromino(grid, tetromino_shape(0, 1), -2, -3);
+
+	CHECK(grid_get(grid, 0, 0));
+	CHECK(!grid_get(grid, 0, 1));
+}
+
+TEST(tetris_collision_codes)
+{
+	Grid board = grid_create(10, 20);
+	grid_set(board, 4, 10, true);
+	tetris_collision collision{ board, 10, 20 };
+
+	// O piece, 2x2 in the box's top left
+	const tetromino_rotation& o = tetromino_shape(3, 0);
+	CHECK_EQ(collision.test(o, 0, 0), 0);
+	CHECK_EQ(collision.test(o, -1, 0), 1);
+	CHECK_EQ(collision.test(o, 9, 0), 2);
+	CHECK_EQ(collision.test(o, 0, 19), 3);
+	CHECK_EQ(collision.test(o, 3, 9), 4);
+	CHECK_EQ(collision.test(o, 5, 9), 0);
+
+	// Above the board is free, but locking there is off the top
+	CHECK_EQ(collision.test(o, 0, -2), 0);
+	CHECK_EQ(collision.test_off_top(o, 0, -1), 5);
+	CHECK_EQ(collision.test_off_top(o, 0, 0), 0);
+}
+
+TEST(tetris_collision_uses_box_not_cells)
+{
+	// Vertical I lives in column 2 of its box, so the box can hang off the left edge
+	Grid board = grid_create(10, 20);
+	tetris_collision collision{ board, 10, 20 };
+	const tetromino_rotation& i = tetromino_shape(0, 1);
+
+	CHECK_EQ(collision.test(i, -2, 0), 0);
+	CHECK_EQ(collision.test(i, -3, 0), 1);
+	CHECK_EQ(collision.test(i, 7, 0), 0);
+	CHECK_EQ(collision.test(i, 8, 0), 2);
+}
+
+TEST(tetris_ai_enumerates_every_column)
+{
+	// Vertical I fits in all 10 columns, flat I in 7, and the two of each repeat
+	Grid board = grid_create(10, 20);
+	tetris_placement placements[tetris_max_placements];
+	int count = tetris_enumerate_placements(board, 0, 3, -2, placements);
+	CHECK_EQ(count, 34);
+
+	// O turns into itself, so only its 9 columns
+	CHECK_EQ(tetris_enumerate_placements(board, 3, 4, -2, placements), 9);
+	for (int i = 0; i < 9; i++)
+	{
+		CHECK(placements[i].valid);
+		CHECK_EQ(placements[i].y, 18);
+	}
+}
+
+TEST(tetris_ai_evaluate_counts_holes_and_heights)
+{
+	tetris_ai_weights holes_only{ 0, 0, -1, 0 };
+	tetris_ai_weights height_only{ -1, 0, 0, 0 };
+	tetris_ai_weights bumps_only{ 0, 0, 0, -1 };
+
+	Grid board = grid_create(10, 20);
+	grid_set(board, 2, 17, true);
+	grid_set(board, 5, 19, true);
+
+	CHECK_EQ(tetris_evaluate(board, 0, holes_only), -2.0f);
+	CHECK_EQ(tetris_evaluate(board, 0, height_only), -4.0f);
+	CHECK_EQ(tetris_evaluate(board, 0, bumps_only), -8.0f);
+}
+
+TEST(tetris_ai_takes_the_line)
+{
+	// Bottom row full but for column 7, any sane search drops a vertical I there
+	Grid board = grid_create(10, 20);
+	for (int i = 0; i < 10; i++)
+		if (i != 7)
+			grid_set(board, i, 19, true);
+
+	tetris_placement best = tetris_find_best_placement(board, 0, -1, 3, -2, tetris_ai_weights{});
+	CHECK(best.valid);
+
+	CHECK_EQ(tetris_apply_placement(board, 0, best), 1);
+	CHECK_EQ(lowest_occupied_row(board), 19);
+}
+
+TEST(tetris_ai_threads_pick_the_same)
+{
+	Grid board = grid_create(10, 20);
+	for (int i = 0; i < 10; i++)
+		for (int j = 14 + (i % 3); j < 20; j++)
+			if ((i * 7 + j) % 5 != 0)
+				grid_set(board, i, j, true);
+
+	tetris_placement single = tetris_find_best_placement(board, 5, 1, 3, -2, tetris_ai_weights{}, 1);
+	tetris_placement split = tetris_find_best_placement(board, 5, 1, 3, -2, tetris_ai_weights{}, 4);
+	CHECK(single.valid);
+	CHECK_EQ(single.rotation, split.rotation);
+	CHECK_EQ(single.x, split.x);
+	CHECK_EQ(single.y, split.y);
+}
+
+TEST(tetris_ai_keeps_the_board_down)
+{
+	// A few hundred pieces with look-ahead never top out and leave few holes
+	Grid board = grid_create(10, 20);
+	tetris_piece_queue pieces;
+	pieces.reset(1, tetris_randomizer_classic);
+	int lines = 0;
+	for (int n = 0; n < 300; n++)
+	{
+		int piece = pieces.next();
+		tetris_placement best = tetris_find_best_placement(board, piece, pieces.peek(0), 3, -2, tetris_ai_weights{});
+		CHECK(best.valid);
+		if (!best.valid)
+			break;
+		lines += tetris_apply_placement(board, piece, best);
+	}
+
+	CHECK(lines >= 100);
+	CHECK(lowest_occupied_row(board) == -1 || tetris_evaluate(board, 0, tetris_ai_weights{ 0, 0, -1, 0 }) > -4.0f);
+}
+
+TEST(tetris_autoplay_clears_lines)
+{
+	BrickGameFramework& app = test_framework();
+	set_input_script_pc([](unsigned int) { return 0u; });
+
+	unsigned int tetris = 0;
+	while (tetris < game_list.size() && game_list[tetris]->name != "Tetris")
+		tetris++;
+	CHECK(tetris < game_list.size());
+	subgame_tetris& game = static_cast<subgame_tetris&>(*game_list[tetris]);
+
+	game.autoplay = true;
+	app.SwitchToGame(tetris);
+	app.run_frames(3000);
+	CHECK(game.lines_cleared > 0);
+	CHECK(app.running);
+	game.autoplay = false;
+
+	app.SwitchToGame(0);
+	app.run_frames(400);
+}
+
+TEST(tetris_collision_drop_distance)
+{
+	Grid board = grid_create(10, 20);
+	grid_set(board, 4, 12, true);
+	tetris_collision collision{ board, 10, 20 };
+
+	// O at columns 3-4 lands on the block, at 5-6 on the floor
+	CHECK_EQ(collision.drop_distance(tetromino_shape(3, 0), 3, 0), 10);
+	CHECK_EQ(collision.drop_distance(tetromino_shape(3, 0), 5, -2), 20);
+}
+
+TEST(tetris_skyline_matches_collision)
+{
+	BrickGameFramework& game = test_framework();
+	instance_destroy_all();
+	subgame_tetris::obj_tetris_rows* rows = instance_create<subgame_tetris::obj_tetris_rows>(game);
+	tetris_collision collision{ rows->filled_blocks, 10, 20 };
+
+	// Fill part of the board the way the game does, then drop every shape from above
+	unsigned int seed = 7;
+	for (int n = 0; n < 12; n++)
+	{
+		seed = seed * 1103515245 + 12345;
+		int piece = (seed >> 16) % tetromino_count;
+		const tetromino_rotation& shape = tetromino_shape(piece, seed >> 8);
+		int x = (int)((seed >> 20) % 7) - shape.left;
+		rows->lock_piece(shape, x, collision.drop_distance(shape, x, -4) - 4);
+	}
+
+	int incremental[Grid::max_width];
+	std::copy(rows->skyline, rows->skyline + 10, incremental);
+	rows->rebuild_skyline();
+	CHECK(std::equal(incremental, incremental + 10, rows->skyline));
+
+	for (int piece = 0; piece < tetromino_count; piece++)
+		for (int rotation = 0; rotation < tetromino_rotations; rotation++)
+		{
+			const tetromino_rotation& shape = tetromino_shape(piece, rotation);
+			for (int x = -shape.left; x + shape.right < 10; x++)
+				CHECK_EQ(rows->drop_distance(shape, x, -4), collision.drop_distance(shape, x, -4));
+		}
+
+	instance_destroy_all();
+}
+
+TEST(tetris_lock_delay_and_resets)
+{
+	BrickGameFramework& game = test_framework();
+	set_input_script_pc([](unsigned int) { return 0u; });
+	instance_destroy_all();
+	instance_create<subgame_tetris::obj_tetris_rows>(game);
+
+	// O already resting on the floor
+	subgame_tetris::obj_tetromino* piece = instance_create<subgame_tetris::obj_tetromino>(game, 0, 18, 3);
+	piece->lock_delay = 3;
+	CHECK_EQ(piece->drop_distance(), 0);
+
+	piece->step_function();
+	piece->step_function();
+	CHECK(piece->moving);
+
+	// Sliding on the ground starts the delay over
+	piece->move_right();
+	piece->step_function();
+	piece->step_function();
+	CHECK(piece->moving);
+
+	piece->step_function();
+	CHECK(!piece->moving);
+	CHECK(grid_get(piece->rows->filled_blocks, 1, 19));
+
+	instance_destroy_all();
+}
+
+TEST(tetris_hard_drop_locks_at_the_ghost)
+{
+	BrickGameFramework& game = test_framework();
+	instance_destroy_all();
+	subgame_tetris::obj_tetris_rows* rows = instance_create<subgame_tetris::obj_tetris_rows>(game);
+	rows->lock_piece(tetromino_shape(3, 0), 4, 18);
+
+	// Vertical I over the O lands on top of it
+	subgame_tetris::obj_tetromino* piece = instance_create<subgame_tetris::obj_tetromino>(game, 2, -2, 0);
+	piece->angle = 1;
+	CHECK_EQ(piece->drop_distance(), 16);
+
+	piece->hard_drop();
+	CHECK(!piece->moving);
+	CHECK(grid_get(rows->filled_blocks, 4, 14));
+	CHECK(grid_get(rows->filled_blocks, 4, 17));
+	CHECK_EQ(rows->skyline[4], 14);
+
+	instance_destroy_all();
+}
+
+TEST(tetris_bag_deals_every_piece_once)
+{
+	tetris_piece_queue pieces;
+	pieces.reset(12345, tetris_randomizer_bag);
+
+	for (int bag = 0; bag < 50; bag++)
+	{
+		int seen = 0;
+		for (int i = 0; i < tetromino_count; i++)
+			seen |= 1 << pieces.next();
+		CHECK_EQ(seen, (1 << tetromino_count) - 1);
+	}
+}
+
+TEST(tetris_pieces_repeat_from_a_seed)
+{
+	for (tetris_randomizer mode : { tetris_randomizer_bag, tetris_randomizer_classic })
+	{
+		tetris_piece_queue a;
+		tetris_piece_queue b;
+		a.reset(99, mode);
+		b.reset(99, mode);
+
+		// Peeking deep into one doesn't change what either deals
+		for (int i = 0; i < 500; i++)
+		{
+			CHECK_EQ(a.peek(tetris_preview_max - 1), b.peek(tetris_preview_max - 1));
+			int upcoming = a.peek(0);
+			CHECK_EQ(a.next(), upcoming);
+			CHECK_EQ(b.next(), upcoming);
+		}
+		CHECK_EQ(a.taken, 500u);
+	}
+
+	tetris_piece_queue other;
+	tetris_piece_queue again;
+	other.reset(100, tetris_randomizer_bag);
+	again.reset(99, tetris_randomizer_bag);
+	bool differs = false;
+	for (int i = 0; i < 14; i++)
+		differs |= (other.next() != again.next());
+	CHECK(differs);
+}
+
+TEST(tetris_classic_covers_every_piece)
+{
+	tetris_piece_queue pieces;
+	pieces.reset(3, tetris_randomizer_classic);
+
+	int counts[tetromino_count] = {};
+	int repeats = 0;
+	int last = -1;
+	for (int i = 0; i < 7000; i++)
+	{
+		int piece = pieces.next();
+		CHECK(piece >= 0 && piece < tetromino_count);
+		counts[piece] += 1;
+		repeats += (piece == last);
+		last = piece;
+	}
+
+	// About 1 in 7 evens out to each piece, while repeats drop to about 1 in 28
+	for (int i = 0; i < tetromino_count; i++)
+		CHECK(counts[i] > 800 && counts[i] < 1200);
+	CHECK(repeats < 400);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdio>
+
+// Minimal self-registering test runner, keeps the host build free of dependencies.
+//
+//   TEST(grid_set_inside_bounds)
+//   {
+//       CHECK(grid_set(grid, 1, 2, true));
+//   }
+
+typedef void (*test_function)();
+
+struct test_registrar
+{
+	test_registrar(const char* name, test_function function);
+};
+
+void test_failed(const char* file, int line, const char* expression);
+
+#define TEST(name) \
+	static void name(); \
+	static test_registrar name##_registrar(#name, name); \
+	static void name()
+
+#define CHECK(expression) \
+	do { if (!(expression)) test_failed(__FILE__, __LINE__, #expression); } while (0)
+
+#define CHECK_EQ(a, b) CHECK((a) == (b))
+
+class BrickGameFramework;
+// Shared by every test that needs game objects, built on first use
+BrickGameFramework& test_framework();